@@ -1,11 +1,33 @@
 #pragma once
 
-#include <type_traits> // std::move
-#include <memory> // std::unique_ptr
+#include <type_traits> // std::move, std::is_invocable_r_v
+#include <memory> // std::unique_ptr, std::shared_ptr
 #include <algorithm> // std::clamp
 #include <numbers> // std::numbers::pi_v<float>
 #include <vector> // std::vector
-#include <cmath> // std::cos, std::sin
+#include <cmath> // std::cos, std::sin, std::fmod
+#include <limits> // std::numeric_limits
+#include <array> // std::array
+#include <string_view> // std::string_view
+#include <cstdint> // std::uint32_t
+#include <bit> // std::bit_cast
+#include <charconv> // std::from_chars
+#include <cctype> // std::isalnum
+#include <string> // std::string
+#include <map> // std::map
+#include <optional> // std::optional
+#include <coroutine> // std::coroutine_handle
+#include <exception> // std::terminate
+#include <new> // placement new
+#include <utility> // std::exchange
+#include <atomic> // std::atomic
+#include <cstddef> // std::max_align_t, std::ptrdiff_t
+#include <span> // std::span
+#include <cstring> // std::memcpy
+#include <chrono> // std::chrono::steady_clock
+#include <ranges> // std::ranges::range
+#include <mutex> // std::mutex
+#include <concepts> // std::convertible_to
 
 namespace ui
 {
@@ -189,653 +211,2198 @@ namespace ui
 				? (1.0f - OutBounce(1.0f - 2.0f * x)) / 2.0f
 				: (1.0f + OutBounce(2.0f * x - 1.0f)) / 2.0f;
 		}
-	}
-
-	typedef float(*EaseFunction)(float);
-
-	class TimedAnimation
-	{
-	public:
 
-		inline static constexpr float DefaultDuration = 1.0f;
+		template <typename TCurve>
+		concept EaseCurve = std::is_invocable_r_v<float, const TCurve&, float>;
 
-		explicit constexpr TimedAnimation(EaseFunction ease, float durationInSeconds):
-			m_Ease(ease),
-			m_DurationInSeconds(durationInSeconds),
-			m_ElapsedTimeInSeconds(0.0f),
-			m_Forward(true),
-			m_Progress(0.0f)
+		template <float(*TFunction)(float)>
+		struct Curve
 		{
-		}
+			constexpr float operator () (float x) const
+			{
+				return TFunction(x);
+			}
+		};
 
-		bool IsDone() const
+		template <EaseCurve TFirst, EaseCurve TSecond>
+		class MixCurve
 		{
-			return m_ElapsedTimeInSeconds >= m_DurationInSeconds;
-		}
+		public:
 
-		void OnDone()
-		{
-		}
+			constexpr explicit MixCurve(TFirst first, TSecond second, float weight):
+				m_First(std::move(first)),
+				m_Second(std::move(second)),
+				m_Weight(weight)
+			{}
 
-		template <typename T>
-		void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
-		{
-			m_ElapsedTimeInSeconds = std::clamp(m_ElapsedTimeInSeconds + deltaTime, 0.0f, m_DurationInSeconds);
+			constexpr float operator () (float x) const
+			{
+				return std::lerp(m_First(x), m_Second(x), m_Weight);
+			}
 
-			float progress = m_ElapsedTimeInSeconds / m_DurationInSeconds;
-			float x = m_Forward ? progress : (1.0f - progress);
-			m_Progress = m_Ease(x);
-		}
+		private:
 
-		template <typename T>
-		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
-		{
-			return initialValue + (targetValue - initialValue) * m_Progress;
-		}
+			TFirst m_First;
+			TSecond m_Second;
+			float m_Weight;
 
-		void Reverse()
-		{
-			m_Forward = not m_Forward;
-		}
+		};
 
-		void Repeat()
+		template <EaseCurve TFirst, EaseCurve TSecond>
+		class ThenCurve
 		{
-			m_ElapsedTimeInSeconds = 0.0f;
-		}
-
-	private:
+		public:
 
-		EaseFunction m_Ease;
-		float m_DurationInSeconds;
-		float m_ElapsedTimeInSeconds;
-		bool m_Forward;
+			constexpr explicit ThenCurve(TFirst first, TSecond second, float split):
+				m_First(std::move(first)),
+				m_Second(std::move(second)),
+				m_Split(split)
+			{}
 
-		float m_Progress;
+			constexpr float operator () (float x) const
+			{
+				return x < m_Split or m_Split >= 1.0f
+					? m_Split * m_First(x / m_Split)
+					: m_Split + (1.0f - m_Split) * m_Second((x - m_Split) / (1.0f - m_Split));
+			}
 
-	};
+		private:
 
-	template <typename TAnimation>
-	class DelayAnimationDecorator
-	{
-	public:
+			TFirst m_First;
+			TSecond m_Second;
+			float m_Split;
 
-		constexpr explicit DelayAnimationDecorator(TAnimation animation, float delayInSeconds):
-			m_DelayInSeconds(delayInSeconds),
-			m_Animation(std::move(animation))
-		{}
+		};
 
-		bool IsDone() const
+		template <EaseCurve TCurve>
+		class MirrorCurve
 		{
-			return not IsWaiting() and m_Animation.IsDone();
-		}
+		public:
 
-		void OnDone()
-		{
-			m_Animation.OnDone();
-		}
+			constexpr explicit MirrorCurve(TCurve curve):
+				m_Curve(std::move(curve))
+			{}
 
-		template <typename T>
-		void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
-		{
-			if (IsWaiting())
+			constexpr float operator () (float x) const
 			{
-				m_DelayInSeconds -= deltaTime;
-				return;
+				return 1.0f - m_Curve(1.0f - x);
 			}
 
-			m_Animation.Update(initialValue, targetValue, currentValue, deltaTime);
-		}
+		private:
 
-		template <typename T>
-		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+			TCurve m_Curve;
+
+		};
+
+		template <EaseCurve TCurve>
+		class ReverseCurve
 		{
-			if (IsWaiting())
+		public:
+
+			constexpr explicit ReverseCurve(TCurve curve):
+				m_Curve(std::move(curve))
+			{}
+
+			constexpr float operator () (float x) const
 			{
-				return initialValue;
+				return m_Curve(1.0f - x);
 			}
 
-			return m_Animation.GetValue(initialValue, targetValue, currentValue);
-		}
+		private:
 
-		void Repeat()
-		{
-			m_Animation.Repeat();
-		}
+			TCurve m_Curve;
 
-		void Reverse()
+		};
+
+		template <EaseCurve TCurve>
+		class ScaleCurve
 		{
-			m_Animation.Reverse();
-		}
+		public:
 
-	private:
+			constexpr explicit ScaleCurve(TCurve curve, float factor):
+				m_Curve(std::move(curve)),
+				m_Factor(factor)
+			{}
 
-		bool IsWaiting() const
+			constexpr float operator () (float x) const
+			{
+				return m_Factor * m_Curve(x);
+			}
+
+		private:
+
+			TCurve m_Curve;
+			float m_Factor;
+
+		};
+
+		template <EaseCurve TCurve, EaseCurve TTime>
+		class RemapCurve
 		{
-			return m_DelayInSeconds > 0.0f;
-		}
+		public:
 
-		float m_DelayInSeconds;
-		TAnimation m_Animation;
+			constexpr explicit RemapCurve(TCurve curve, TTime time):
+				m_Curve(std::move(curve)),
+				m_Time(std::move(time))
+			{}
 
-	};
+			constexpr float operator () (float x) const
+			{
+				return m_Curve(m_Time(x));
+			}
 
-	template <typename TAnimation>
-	class SpeedAnimationDecorator
-	{
-	public:
+		private:
 
-		constexpr explicit SpeedAnimationDecorator(TAnimation animation, float speedFactor) :
-			m_SpeedFactor(speedFactor),
-			m_Animation(std::move(animation))
-		{}
+			TCurve m_Curve;
+			TTime m_Time;
 
-		bool IsDone() const
+		};
+
+		template <EaseCurve TFirst, EaseCurve TSecond>
+		constexpr MixCurve<TFirst, TSecond> Mix(TFirst first, TSecond second, float weight)
 		{
-			return m_Animation.IsDone();
+			return MixCurve<TFirst, TSecond>(std::move(first), std::move(second), weight);
 		}
 
-		void OnDone()
+		template <EaseCurve TFirst, EaseCurve TSecond>
+		constexpr ThenCurve<TFirst, TSecond> Then(TFirst first, TSecond second, float split = 0.5f)
 		{
-			m_Animation.OnDone();
+			return ThenCurve<TFirst, TSecond>(std::move(first), std::move(second), split);
 		}
 
-		template <typename T>
-		void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		template <EaseCurve TCurve>
+		constexpr MirrorCurve<TCurve> Mirror(TCurve curve)
 		{
-			m_Animation.Update(initialValue, targetValue, currentValue, deltaTime * m_SpeedFactor);
+			return MirrorCurve<TCurve>(std::move(curve));
 		}
 
-		template <typename T>
-		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		template <EaseCurve TCurve>
+		constexpr ReverseCurve<TCurve> Reverse(TCurve curve)
 		{
-			return m_Animation.GetValue(initialValue, targetValue, currentValue);
+			return ReverseCurve<TCurve>(std::move(curve));
 		}
 
-		void Repeat()
+		template <EaseCurve TCurve>
+		constexpr ScaleCurve<TCurve> Scale(TCurve curve, float factor)
 		{
-			m_Animation.Repeat();
+			return ScaleCurve<TCurve>(std::move(curve), factor);
 		}
 
-		void Reverse()
+		template <EaseCurve TCurve, EaseCurve TTime>
+		constexpr RemapCurve<TCurve, TTime> Remap(TCurve curve, TTime time)
 		{
-			m_Animation.Reverse();
+			return RemapCurve<TCurve, TTime>(std::move(curve), std::move(time));
 		}
 
-	private:
+		enum class Mode
+		{
+			In,
+			Out,
+			InOut
+		};
 
-		float m_SpeedFactor;
-		TAnimation m_Animation;
+		template <typename TIn>
+		constexpr float WithMode(Mode mode, float x, const TIn& in)
+		{
+			switch (mode)
+			{
+				case Mode::Out:
+					return 1.0f - in(1.0f - x);
+				case Mode::InOut:
+					return x < 0.5f ? in(2.0f * x) / 2.0f : 1.0f - in(2.0f - 2.0f * x) / 2.0f;
+				default:
+					return in(x);
+			}
+		}
 
-	};
+		class BackCurve
+		{
+		public:
 
-	template <typename TAnimation, typename TRepeatPredicate, typename TReversePredicate>
-	class RepeatAnimationDecorator
-	{
-	public:
+			constexpr explicit BackCurve(float overshoot, Mode mode):
+				m_Overshoot(mode == Mode::InOut ? overshoot * 1.525f : overshoot),
+				m_Mode(mode)
+			{}
 
-		constexpr explicit RepeatAnimationDecorator(TAnimation animation, TRepeatPredicate repeatPredicate, TReversePredicate reversePredicate):
-			m_Animation(std::move(animation)),
-			m_RepeatPredicate(std::move(repeatPredicate)),
-			m_ReversePredicate(reversePredicate)
-		{}
+			constexpr float operator () (float x) const
+			{
+				return WithMode(m_Mode, x, [this](float t)
+				{
+					return (m_Overshoot + 1.0f) * t * t * t - m_Overshoot * t * t;
+				});
+			}
 
-		bool IsDone() const
+		private:
+
+			float m_Overshoot;
+			Mode m_Mode;
+
+		};
+
+		class ElasticCurve
 		{
-			return m_Animation.IsDone();
-		}
+		public:
 
-		void OnDone()
+			explicit ElasticCurve(float amplitude, float period, Mode mode):
+				m_Amplitude(std::max(amplitude, 1.0f)),
+				m_Period(mode == Mode::InOut ? period * 1.5f : period),
+				m_Shift(m_Period / (2.0f * std::numbers::pi_v<float>) * std::asin(1.0f / m_Amplitude)),
+				m_Mode(mode)
+			{}
+
+			float operator () (float x) const
+			{
+				return WithMode(m_Mode, x, [this](float t)
+				{
+					if (t <= 0.0f or t >= 1.0f)
+						return t <= 0.0f ? 0.0f : 1.0f;
+
+					return -m_Amplitude * std::pow(2.0f, 10.0f * t - 10.0f)
+						* std::sin((t - 1.0f - m_Shift) * (2.0f * std::numbers::pi_v<float>) / m_Period);
+				});
+			}
+
+		private:
+
+			float m_Amplitude;
+			float m_Period;
+			float m_Shift;
+			Mode m_Mode;
+
+		};
+
+		class BounceCurve
 		{
-			if (m_RepeatPredicate())
+		public:
+
+			constexpr explicit BounceCurve(std::size_t bounces, float restitution, Mode mode):
+				m_Bounces(bounces),
+				m_Restitution(restitution),
+				m_Width(1.0f),
+				m_Mode(mode)
+			{
+				float width = 2.0f * restitution;
+				for (std::size_t i = 0; i < bounces; ++i, width *= restitution)
+				{
+					m_Width += width;
+				}
+			}
+
+			constexpr float operator () (float x) const
+			{
+				return WithMode(m_Mode, x, [this](float t)
+				{
+					return 1.0f - Out(1.0f - t);
+				});
+			}
+
+		private:
+
+			constexpr float Out(float x) const
 			{
-				Repeat();
+				float t = x * m_Width;
+				if (t < 1.0f)
+				{
+					return t * t;
+				}
 
-				if (m_ReversePredicate())
+				float start = 1.0f;
+				float width = 2.0f * m_Restitution;
+				for (std::size_t i = 0; i < m_Bounces; ++i, width *= m_Restitution)
 				{
-					Reverse();
+					if (t < start + width)
+					{
+						float u = t - start - width / 2.0f;
+						return 1.0f - width * width / 4.0f + u * u;
+					}
+
+					start += width;
 				}
+
+				return 1.0f;
 			}
-		}
 
-		template <typename T>
-		void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+			std::size_t m_Bounces;
+			float m_Restitution;
+			float m_Width;
+			Mode m_Mode;
+
+		};
+
+		constexpr BackCurve Back(float overshoot = 1.70158f, Mode mode = Mode::In)
 		{
-			m_Animation.Update(initialValue, targetValue, currentValue, deltaTime);
+			return BackCurve(overshoot, mode);
 		}
 
-		template <typename T>
-		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		inline ElasticCurve Elastic(float amplitude = 1.0f, float period = 0.3f, Mode mode = Mode::In)
 		{
-			return m_Animation.GetValue(initialValue, targetValue, currentValue);
+			return ElasticCurve(amplitude, period, mode);
 		}
 
-		void Repeat()
+		constexpr BounceCurve Bounce(std::size_t bounces = 3, float restitution = 0.5f, Mode mode = Mode::Out)
 		{
-			m_Animation.Repeat();
+			return BounceCurve(bounces, restitution, mode);
 		}
 
-		void Reverse()
+		// Rises to 1 and falls back to 0, for additive effects.
+		inline float Pulse(float x)
 		{
-			m_Animation.Reverse();
+			return std::sin(std::numbers::pi_v<float> * x);
 		}
 
-	private:
+		// Swings around 0 with a decaying amplitude and ends at 0, for additive effects.
+		class ShakeCurve
+		{
+		public:
 
-		TAnimation m_Animation;
-		TRepeatPredicate m_RepeatPredicate;
-		TReversePredicate m_ReversePredicate;
+			explicit ShakeCurve(float oscillations, float damping):
+				m_Frequency(2.0f * std::numbers::pi_v<float> * oscillations),
+				m_Damping(std::max(damping, 0.0f))
+			{}
 
-	};
+			float operator () (float x) const
+			{
+				return std::sin(m_Frequency * x) * std::pow(std::max(1.0f - x, 0.0f), m_Damping);
+			}
 
-	struct Predicate
-	{
-		inline static constexpr auto Always = [] { return true; };
-		inline static constexpr auto Never = [] { return false; };
-		
-		typedef decltype(Always) AlwaysType;
-		typedef decltype(Never) NeverType;
-	};
-	
-	template <typename TAnimation>
-	class AnimationBuilder
-	{
-	public:
+		private:
 
-		explicit constexpr AnimationBuilder(TAnimation animation):
-			m_Animation(std::move(animation))
-		{}
+			float m_Frequency;
+			float m_Damping;
 
-		auto Delay(float delayInSeconds) const
+		};
+
+		inline ShakeCurve Shake(float oscillations = 4.0f, float damping = 1.0f)
 		{
-			return AnimationBuilder<DelayAnimationDecorator<TAnimation>>(
-				DelayAnimationDecorator<TAnimation>(
-					m_Animation,
-					delayInSeconds
-				)
-			);
+			return ShakeCurve(oscillations, damping);
 		}
 
-		auto Speed(float speedFactor) const
+		struct NamedFunction
 		{
-			return AnimationBuilder<SpeedAnimationDecorator<TAnimation>>(
-				SpeedAnimationDecorator<TAnimation>(
-					m_Animation,
-					speedFactor
-				)
-			);
-		}
+			std::string_view Name;
+			float(*Function)(float);
+		};
 
-		template <
-			typename TRepeatPredicate = Predicate::AlwaysType,
-			typename TReversePredicate = Predicate::NeverType
-		>
-		auto Repeat(
-			TRepeatPredicate repeatPredicate = Predicate::Always,
-			TReversePredicate reversePredicate = Predicate::Never
-		) const
+		inline constexpr std::array<NamedFunction, 31> Functions = { {
+			{ "Linear", &Linear },
+			{ "InSine", &InSine },
+			{ "OutSine", &OutSine },
+			{ "InOutSine", &InOutSine },
+			{ "InCubic", &InCubic },
+			{ "OutCubic", &OutCubic },
+			{ "InOutCubic", &InOutCubic },
+			{ "InQuint", &InQuint },
+			{ "OutQuint", &OutQuint },
+			{ "InOutQuint", &InOutQuint },
+			{ "InCirc", &InCirc },
+			{ "OutCirc", &OutCirc },
+			{ "InOutCirc", &InOutCirc },
+			{ "InElastic", &InElastic },
+			{ "OutElastic", &OutElastic },
+			{ "InOutElastic", &InOutElastic },
+			{ "InQuad", &InQuad },
+			{ "OutQuad", &OutQuad },
+			{ "InOutQuad", &InOutQuad },
+			{ "InQuart", &InQuart },
+			{ "OutQuart", &OutQuart },
+			{ "InOutQuart", &InOutQuart },
+			{ "InExpo", &InExpo },
+			{ "OutExpo", &OutExpo },
+			{ "InOutExpo", &InOutExpo },
+			{ "InBack", &InBack },
+			{ "OutBack", &OutBack },
+			{ "InOutBack", &InOutBack },
+			{ "InBounce", &InBounce },
+			{ "OutBounce", &OutBounce },
+			{ "InOutBounce", &InOutBounce }
+		} };
+
+		struct PerfectHashTable
 		{
-			return AnimationBuilder<RepeatAnimationDecorator<TAnimation, TRepeatPredicate, TReversePredicate>>(
-				RepeatAnimationDecorator<TAnimation, TRepeatPredicate, TReversePredicate>(
-					m_Animation,
-					std::move(repeatPredicate),
-					std::move(reversePredicate)
-				)
-			);
-		}
+			inline static constexpr std::size_t Size = 64;
 
-		template <typename TReversePredicate = Predicate::NeverType>
-		auto RepeatFor(
-			std::size_t count,
-			TReversePredicate reversePredicate = Predicate::Never
-		) const
-		{
-			auto repeatPredicate = [count, i = (std::size_t)0]() mutable
+			std::uint32_t Seed = 0;
+			std::array<std::uint8_t, Size> Slots{};
+
+			static constexpr std::size_t Hash(std::string_view name, std::uint32_t seed)
 			{
-				return ++i < count;
-			};
+				std::uint32_t hash = 2166136261u ^ seed;
+				for (char c : name)
+				{
+					hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+				}
 
-			return AnimationBuilder<RepeatAnimationDecorator<TAnimation, decltype(repeatPredicate), TReversePredicate>>(
-				RepeatAnimationDecorator<TAnimation, decltype(repeatPredicate), TReversePredicate>(
-					m_Animation,
-					std::move(repeatPredicate),
-					std::move(reversePredicate)
-				)
-			);
-		}
+				return (hash ^ (hash >> 15)) % Size;
+			}
 
-		template <typename TRepeatPredicate = Predicate::AlwaysType>
-		auto ReverseFor(
-			std::size_t count,
-			TRepeatPredicate repeatPredicate = Predicate::Always
-		) const
+			static consteval PerfectHashTable Build()
+			{
+				static_assert(Functions.size() < Size);
+
+				for (std::uint32_t seed = 0;; ++seed)
+				{
+					PerfectHashTable table;
+					table.Seed = seed;
+
+					bool collision = false;
+					for (std::size_t i = 0; i < Functions.size() and not collision; ++i)
+					{
+						std::uint8_t& slot = table.Slots[Hash(Functions[i].Name, seed)];
+						collision = slot != 0;
+						slot = static_cast<std::uint8_t>(i + 1);
+					}
+
+					if (not collision)
+					{
+						return table;
+					}
+				}
+			}
+		};
+
+		inline constexpr PerfectHashTable FunctionTable = PerfectHashTable::Build();
+
+		inline std::size_t FindIndex(std::string_view name)
 		{
-			auto reversePredicate = [count, i = (std::size_t)0]() mutable
+			std::uint8_t slot = FunctionTable.Slots[PerfectHashTable::Hash(name, FunctionTable.Seed)];
+			if (slot == 0 or Functions[slot - 1].Name != name)
 			{
-				return i++ < count;
-			};
+				return Functions.size();
+			}
 
-			return AnimationBuilder<RepeatAnimationDecorator<TAnimation, TRepeatPredicate, decltype(reversePredicate)>>(
-				RepeatAnimationDecorator<TAnimation, TRepeatPredicate, decltype(reversePredicate)>(
-					m_Animation,
-					std::move(repeatPredicate),
-					std::move(reversePredicate)
-				)
-			);
+			return slot - 1;
 		}
 
-		const TAnimation& GetAnimation() const
+		inline float(*Find(std::string_view name))(float)
 		{
-			return m_Animation;
+			std::size_t index = FindIndex(name);
+			return index < Functions.size() ? Functions[index].Function : nullptr;
 		}
+	}
 
-	private:
+	typedef float(*EaseFunction)(float);
+	typedef std::chrono::nanoseconds Ticks;
 
-		TAnimation m_Animation;
+	// Rounds half away from zero like std::llround, which is not inlined and would cost more than
+	// the rest of a compiled update; 1.0 / 60 s becomes 16666667 ns rather than 16666666.
+	inline Ticks ToTicks(double seconds)
+	{
+		constexpr double Limit = static_cast<double>(std::numeric_limits<Ticks::rep>::max() / Ticks::period::den);
+		double ticks = std::clamp(seconds, -Limit, Limit) * Ticks::period::den;
+		return Ticks(static_cast<Ticks::rep>(ticks < 0.0 ? ticks - 0.5 : ticks + 0.5));
+	}
 
-	};
+	inline double ToSeconds(Ticks ticks)
+	{
+		return static_cast<double>(ticks.count()) * (1.0 / Ticks::period::den);
+	}
 
-	class InstantAnimation
+	class AnimationPlan;
+
+	template <typename TCurve>
+	class BasicTimedAnimation
 	{
 	public:
 
-		constexpr InstantAnimation() = default;
+		inline static constexpr float DefaultDuration = 1.0f;
+
+		explicit constexpr BasicTimedAnimation(TCurve ease, float durationInSeconds):
+			m_Ease(std::move(ease)),
+			m_DurationInSeconds(durationInSeconds),
+			m_InverseDuration(durationInSeconds > 0.0f ? 1.0f / durationInSeconds : 0.0f),
+			m_ElapsedTimeInSeconds(0.0f),
+			m_Forward(true),
+			m_Progress(0.0f)
+		{
+		}
 
 		bool IsDone() const
 		{
-			return true;
+			return m_ElapsedTimeInSeconds >= m_DurationInSeconds;
 		}
 
-		void OnDone() const
+		void OnDone()
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return 0;
+		}
+
+		float GetCycleDurationInSeconds() const
 		{
+			return m_DurationInSeconds;
 		}
 
 		template <typename T>
-		void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
 		{
+			float elapsedTimeInSeconds = m_ElapsedTimeInSeconds + deltaTime;
+			m_ElapsedTimeInSeconds = std::min(elapsedTimeInSeconds, m_DurationInSeconds);
+
+			float progress = 0.0f;
+			if (IsDone())
+			{
+				progress = 1.0f;
+			}
+			else if (m_ElapsedTimeInSeconds > 0.0f)
+			{
+				progress = m_ElapsedTimeInSeconds * m_InverseDuration;
+			}
+
+			float x = m_Forward ? progress : (1.0f - progress);
+			m_Progress = m_Ease(x);
+
+			return std::max(elapsedTimeInSeconds - m_DurationInSeconds, 0.0f);
 		}
 
 		template <typename T>
 		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
 		{
-			return targetValue;
+			// A folded delay holds the initial value, as DelayAnimationDecorator does.
+			if (m_ElapsedTimeInSeconds < 0.0f)
+			{
+				return initialValue;
+			}
+
+			return initialValue + (targetValue - initialValue) * m_Progress;
+		}
+
+		void Reverse()
+		{
+			m_Forward = not m_Forward;
 		}
 
-		void Repeat() const
+		void Repeat()
 		{
+			m_ElapsedTimeInSeconds = 0.0f;
 		}
 
-		void Reverse() const
+		void ApplySpeed(float speedFactor)
+		{
+			speedFactor = std::max(speedFactor, 0.0f);
+
+			m_DurationInSeconds /= speedFactor;
+			m_InverseDuration *= speedFactor;
+			m_ElapsedTimeInSeconds = m_ElapsedTimeInSeconds < 0.0f ? m_ElapsedTimeInSeconds / speedFactor : 0.0f;
+		}
+
+		void ApplyDelay(float delayInSeconds)
 		{
+			m_ElapsedTimeInSeconds -= delayInSeconds;
 		}
 
+	private:
+
+		friend class AnimationPlan;
+
+		TCurve m_Ease;
+		float m_DurationInSeconds;
+		float m_InverseDuration;
+		float m_ElapsedTimeInSeconds;
+		bool m_Forward;
+
+		float m_Progress;
+
 	};
 
-	class NeverAnimation
+	typedef BasicTimedAnimation<EaseFunction> TimedAnimation;
+
+	// Animation types written before Update returned its unused time, or before loops and cycle
+	// durations were reported, keep working: a missing result falls back to the old behaviour.
+	template <typename TAnimation, typename T, typename TTime>
+	float UpdateAnimation(TAnimation& animation, const T& initialValue, const T& targetValue, const T& currentValue, TTime deltaTime)
+	{
+		if constexpr (std::is_void_v<decltype(animation.Update(initialValue, targetValue, currentValue, deltaTime))>)
+		{
+			animation.Update(initialValue, targetValue, currentValue, deltaTime);
+			return 0.0f;
+		}
+		else
+		{
+			return static_cast<float>(animation.Update(initialValue, targetValue, currentValue, deltaTime));
+		}
+	}
+
+	template <typename TAnimation>
+	std::size_t GetAnimationLoopCount(const TAnimation& animation)
+	{
+		if constexpr (requires { animation.GetLoopCount(); })
+			return animation.GetLoopCount();
+		else
+			return 0;
+	}
+
+	// Unknown durations count as endless, so a repeat restarts once instead of catching up.
+	template <typename TAnimation>
+	float GetAnimationCycleDuration(const TAnimation& animation)
+	{
+		if constexpr (requires { animation.GetCycleDurationInSeconds(); })
+			return animation.GetCycleDurationInSeconds();
+		else
+			return std::numeric_limits<float>::infinity();
+	}
+
+	template <typename TAnimation>
+	class DelayAnimationDecorator
 	{
 	public:
 
-		constexpr NeverAnimation() = default;
+		constexpr explicit DelayAnimationDecorator(TAnimation animation, float delayInSeconds):
+			m_DelayInSeconds(delayInSeconds),
+			m_Animation(std::move(animation))
+		{}
 
 		bool IsDone() const
 		{
-			return false;
+			return not IsWaiting() and m_Animation.IsDone();
 		}
 
-		void OnDone() const
+		void OnDone()
+		{
+			m_Animation.OnDone();
+		}
+
+		std::size_t GetLoopCount() const
 		{
+			return GetAnimationLoopCount(m_Animation);
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return GetAnimationCycleDuration(m_Animation);
 		}
 
 		template <typename T>
-		void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
 		{
+			if (IsWaiting())
+			{
+				m_DelayInSeconds -= deltaTime;
+
+				if (IsWaiting())
+				{
+					return 0.0f;
+				}
+
+				deltaTime = -m_DelayInSeconds;
+				m_DelayInSeconds = 0.0f;
+			}
+
+			return UpdateAnimation(m_Animation, initialValue, targetValue, currentValue, deltaTime);
 		}
 
 		template <typename T>
 		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
 		{
-			return initialValue;
+			if (IsWaiting())
+			{
+				return initialValue;
+			}
+
+			return m_Animation.GetValue(initialValue, targetValue, currentValue);
 		}
 
-		void Repeat() const
+		void Repeat()
 		{
+			m_Animation.Repeat();
 		}
 
-		void Reverse() const
+		void Reverse()
+		{
+			m_Animation.Reverse();
+		}
+
+		void ApplySpeed(float speedFactor) requires requires(TAnimation& animation, float value) { animation.ApplySpeed(value); }
+		{
+			if (IsWaiting())
+			{
+				m_DelayInSeconds /= std::max(speedFactor, 0.0f);
+			}
+
+			m_Animation.ApplySpeed(speedFactor);
+		}
+
+		void ApplyDelay(float delayInSeconds)
+		{
+			m_DelayInSeconds += delayInSeconds;
+		}
+
+	private:
+
+		friend class AnimationPlan;
+
+		bool IsWaiting() const
 		{
+			return m_DelayInSeconds > 0.0f;
 		}
 
+		float m_DelayInSeconds;
+		TAnimation m_Animation;
+
 	};
 
-	class TimingCurveAnimation
+	template <typename TAnimation>
+	class SpeedAnimationDecorator
 	{
 	public:
 
-		template <std::ranges::range TValues, std::ranges::range TFunctions>
-		constexpr explicit TimingCurveAnimation(float durationInSeconds, TValues values, TFunctions functions):
-			m_Values(std::ranges::begin(values), std::ranges::end(values)),
-			m_Functions(std::ranges::begin(functions), std::ranges::end(functions)),
-			m_DurationInSeconds(durationInSeconds),
-			m_Value(m_Values.empty() ? 0.0f : m_Values.front())
-		{
-		}
+		constexpr explicit SpeedAnimationDecorator(TAnimation animation, float speedFactor) :
+			m_SpeedFactor(speedFactor),
+			m_Animation(std::move(animation))
+		{}
 
 		bool IsDone() const
 		{
-			return m_ValueIndex >= m_Values.size();
+			return m_Animation.IsDone();
 		}
 
-		void OnDone() const
+		void OnDone()
 		{
+			m_Animation.OnDone();
 		}
 
-		template <typename T>
-		void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		std::size_t GetLoopCount() const
 		{
-			float durationPerValue = m_DurationInSeconds / static_cast<float>(m_Values.size());
-			m_ElapsedTimeInSeconds = std::clamp(m_ElapsedTimeInSeconds + deltaTime, 0.0f, durationPerValue);
+			return GetAnimationLoopCount(m_Animation);
+		}
 
-			float progress = m_ElapsedTimeInSeconds / durationPerValue;
-			EaseFunction ease = GetFunction();
-			float previousTarget = GetPreviousTargetValue();
-			float target = GetTargetValue();
-			m_Value = std::lerp(previousTarget, target, ease(progress));
+		float GetCycleDurationInSeconds() const
+		{
+			return GetAnimationCycleDuration(m_Animation) / m_SpeedFactor;
+		}
 
-			if (m_ElapsedTimeInSeconds >= durationPerValue)
-			{
-				++m_ValueIndex;
-				m_ElapsedTimeInSeconds = 0.0f;
-			}
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			float remainingTime = UpdateAnimation(m_Animation, initialValue, targetValue, currentValue, deltaTime * m_SpeedFactor);
+			return m_SpeedFactor > 0.0f ? remainingTime / m_SpeedFactor : 0.0f;
 		}
 
 		template <typename T>
 		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
 		{
-			return initialValue + (targetValue - initialValue) * m_Value;
+			return m_Animation.GetValue(initialValue, targetValue, currentValue);
 		}
 
 		void Repeat()
 		{
-			m_ValueIndex = 1;
+			m_Animation.Repeat();
 		}
 
 		void Reverse()
 		{
-			std::ranges::reverse(m_Values);
-			std::ranges::reverse(m_Functions);
+			m_Animation.Reverse();
 		}
 
-	private:
-
-		float GetPreviousTargetValue() const
+		void ApplySpeed(float speedFactor)
 		{
-			if (m_Values.empty())
-				return 0.0f;
-
-			return m_Values[std::min(m_ValueIndex - 1, m_Values.size() - 1)];
+			m_SpeedFactor *= speedFactor;
 		}
 
-		float GetTargetValue() const
+		void ApplyDelay(float delayInSeconds) requires requires(TAnimation& animation, float value) { animation.ApplyDelay(value); }
 		{
-			if (m_Values.empty())
-				return 0.0f;
-
-			return m_Values[std::min(m_ValueIndex, m_Values.size() - 1)];
+			m_Animation.ApplyDelay(delayInSeconds * m_SpeedFactor);
 		}
 
-		EaseFunction GetFunction() const
-		{
-			if (m_Functions.empty())
-				return &ease::Linear;
-
-			return m_Functions[std::min(m_ValueIndex - 1, m_Functions.size() - 1)];
-		}
+	private:
 
-		std::vector<float> m_Values;
-		std::vector<EaseFunction> m_Functions;
+		friend class AnimationPlan;
 
-		float m_ElapsedTimeInSeconds = 0.0f;
-		float m_DurationInSeconds;
-		std::size_t m_ValueIndex = 1;
-		float m_Value;
+		float m_SpeedFactor;
+		TAnimation m_Animation;
 
 	};
 
-	constexpr AnimationBuilder<TimedAnimation> EaseLinear(float durationInSeconds = TimedAnimation::DefaultDuration)
-	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::Linear,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInSine(float durationInSeconds = TimedAnimation::DefaultDuration)
+	template <typename TAnimation, typename TRepeatPredicate, typename TReversePredicate>
+	class RepeatAnimationDecorator
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InSine,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseOutSine(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		constexpr explicit RepeatAnimationDecorator(TAnimation animation, TRepeatPredicate repeatPredicate, TReversePredicate reversePredicate):
+			m_Animation(std::move(animation)),
+			m_RepeatPredicate(std::move(repeatPredicate)),
+			m_ReversePredicate(reversePredicate)
+		{}
+
+		bool IsDone() const
+		{
+			return m_Animation.IsDone();
+		}
+
+		void OnDone()
+		{
+			if (m_Exhausted)
+			{
+				return;
+			}
+
+			// A nested repeat takes its turn first, as it does when a step overshoots the cycle in Update.
+			m_Animation.OnDone();
+			if (not m_Animation.IsDone())
+			{
+				return;
+			}
+
+			if (not m_RepeatPredicate())
+			{
+				m_Exhausted = true;
+				return;
+			}
+
+			Repeat();
+			++m_LoopCount;
+
+			if (m_ReversePredicate())
+			{
+				Reverse();
+			}
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return m_LoopCount;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return std::numeric_limits<float>::infinity();
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			float remainingTime = UpdateAnimation(m_Animation, initialValue, targetValue, currentValue, deltaTime);
+
+			if (m_Exhausted or remainingTime <= 0.0f or not m_Animation.IsDone())
+			{
+				return remainingTime;
+			}
+
+			float cycleDuration = GetAnimationCycleDuration(m_Animation);
+			if (not (cycleDuration > 0.0f))
+			{
+				return 0.0f;
+			}
+
+			// The remaining time spans `cycles` restarts, the last one ending `phase` seconds into its pass.
+			std::size_t cycles = 1;
+			float phase = remainingTime;
+
+			if (not std::isinf(cycleDuration))
+			{
+				phase = std::fmod(remainingTime, cycleDuration);
+				if (phase <= 0.0f)
+				{
+					phase = cycleDuration;
+				}
+
+				double fullCycles = std::round((static_cast<double>(remainingTime) - phase) / cycleDuration);
+				cycles = fullCycles >= static_cast<double>(std::numeric_limits<std::size_t>::max() - 1)
+					? std::numeric_limits<std::size_t>::max()
+					: static_cast<std::size_t>(fullCycles) + 1;
+			}
+
+			std::size_t repeats = TakeRepeats(m_RepeatPredicate, cycles);
+			if (repeats == 0)
+			{
+				m_Exhausted = true;
+				return remainingTime;
+			}
+
+			std::size_t reverses = TakeReverses(m_ReversePredicate, repeats);
+
+			Repeat();
+			m_LoopCount += repeats;
+
+			if (reverses % 2 == 1)
+			{
+				Reverse();
+			}
+
+			if (repeats < cycles)
+			{
+				m_Exhausted = true;
+				phase = remainingTime - static_cast<float>(repeats - 1) * cycleDuration;
+			}
+
+			return UpdateAnimation(m_Animation, initialValue, targetValue, currentValue, phase);
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			return m_Animation.GetValue(initialValue, targetValue, currentValue);
+		}
+
+		void Repeat()
+		{
+			m_Animation.Repeat();
+		}
+
+		void Reverse()
+		{
+			m_Animation.Reverse();
+		}
+
+		void ApplySpeed(float speedFactor) requires requires(TAnimation& animation, float value) { animation.ApplySpeed(value); }
+		{
+			m_Animation.ApplySpeed(speedFactor);
+		}
+
+		void ApplyDelay(float delayInSeconds) requires requires(TAnimation& animation, float value) { animation.ApplyDelay(value); }
+		{
+			m_Animation.ApplyDelay(delayInSeconds);
+		}
+
+	private:
+
+		friend class AnimationPlan;
+
+		template <typename TPredicate>
+		static std::size_t TakeRepeats(TPredicate& predicate, std::size_t count)
+		{
+			if constexpr (requires { predicate.Take(count); })
+			{
+				return predicate.Take(count);
+			}
+			else
+			{
+				std::size_t taken = 0;
+				while (taken < count and predicate())
+				{
+					++taken;
+				}
+
+				return taken;
+			}
+		}
+
+		template <typename TPredicate>
+		static std::size_t TakeReverses(TPredicate& predicate, std::size_t count)
+		{
+			if constexpr (requires { predicate.Take(count); })
+			{
+				return predicate.Take(count);
+			}
+			else
+			{
+				std::size_t taken = 0;
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					taken += predicate() ? 1 : 0;
+				}
+
+				return taken;
+			}
+		}
+
+		TAnimation m_Animation;
+		TRepeatPredicate m_RepeatPredicate;
+		TReversePredicate m_ReversePredicate;
+		bool m_Exhausted = false;
+		std::size_t m_LoopCount = 0;
+
+	};
+
+	struct Predicate
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::OutSine,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInOutSine(float durationInSeconds = TimedAnimation::DefaultDuration)
+		struct AlwaysType
+		{
+			constexpr bool operator () () const { return true; }
+			constexpr std::size_t Take(std::size_t count) const { return count; }
+		};
+
+		struct NeverType
+		{
+			constexpr bool operator () () const { return false; }
+			constexpr std::size_t Take(std::size_t) const { return 0; }
+		};
+
+		class Countdown
+		{
+		public:
+
+			constexpr explicit Countdown(std::size_t count):
+				m_Remaining(count)
+			{}
+
+			constexpr bool operator () ()
+			{
+				return Take(1) == 1;
+			}
+
+			constexpr std::size_t Take(std::size_t count)
+			{
+				std::size_t taken = std::min(count, m_Remaining);
+				m_Remaining -= taken;
+				return taken;
+			}
+
+			constexpr std::size_t GetRemaining() const
+			{
+				return m_Remaining;
+			}
+
+		private:
+
+			std::size_t m_Remaining;
+
+		};
+
+		inline static constexpr AlwaysType Always{};
+		inline static constexpr NeverType Never{};
+	};
+	
+	template <typename TAnimation>
+	class AnimationBuilder
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InOutSine,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInCubic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		explicit constexpr AnimationBuilder(TAnimation animation):
+			m_Animation(std::move(animation))
+		{}
+
+		auto Delay(float delayInSeconds) const
+		{
+			if constexpr (requires(TAnimation& animation, float value) { animation.ApplyDelay(value); })
+			{
+				TAnimation animation = m_Animation;
+				animation.ApplyDelay(delayInSeconds);
+				return AnimationBuilder<TAnimation>(std::move(animation));
+			}
+			else
+			{
+				return AnimationBuilder<DelayAnimationDecorator<TAnimation>>(
+					DelayAnimationDecorator<TAnimation>(
+						m_Animation,
+						delayInSeconds
+					)
+				);
+			}
+		}
+
+		auto Speed(float speedFactor) const
+		{
+			if constexpr (requires(TAnimation& animation, float value) { animation.ApplySpeed(value); })
+			{
+				TAnimation animation = m_Animation;
+				animation.ApplySpeed(speedFactor);
+				return AnimationBuilder<TAnimation>(std::move(animation));
+			}
+			else
+			{
+				return AnimationBuilder<SpeedAnimationDecorator<TAnimation>>(
+					SpeedAnimationDecorator<TAnimation>(
+						m_Animation,
+						speedFactor
+					)
+				);
+			}
+		}
+
+		template <
+			typename TRepeatPredicate = Predicate::AlwaysType,
+			typename TReversePredicate = Predicate::NeverType
+		>
+		auto Repeat(
+			TRepeatPredicate repeatPredicate = Predicate::Always,
+			TReversePredicate reversePredicate = Predicate::Never
+		) const
+		{
+			return AnimationBuilder<RepeatAnimationDecorator<TAnimation, TRepeatPredicate, TReversePredicate>>(
+				RepeatAnimationDecorator<TAnimation, TRepeatPredicate, TReversePredicate>(
+					m_Animation,
+					std::move(repeatPredicate),
+					std::move(reversePredicate)
+				)
+			);
+		}
+
+		template <typename TReversePredicate = Predicate::NeverType>
+		auto RepeatFor(
+			std::size_t count,
+			TReversePredicate reversePredicate = Predicate::Never
+		) const
+		{
+			auto repeatPredicate = Predicate::Countdown(count > 0 ? count - 1 : 0);
+
+			return AnimationBuilder<RepeatAnimationDecorator<TAnimation, decltype(repeatPredicate), TReversePredicate>>(
+				RepeatAnimationDecorator<TAnimation, decltype(repeatPredicate), TReversePredicate>(
+					m_Animation,
+					std::move(repeatPredicate),
+					std::move(reversePredicate)
+				)
+			);
+		}
+
+		template <typename TRepeatPredicate = Predicate::AlwaysType>
+		auto ReverseFor(
+			std::size_t count,
+			TRepeatPredicate repeatPredicate = Predicate::Always
+		) const
+		{
+			auto reversePredicate = Predicate::Countdown(count);
+
+			return AnimationBuilder<RepeatAnimationDecorator<TAnimation, TRepeatPredicate, decltype(reversePredicate)>>(
+				RepeatAnimationDecorator<TAnimation, TRepeatPredicate, decltype(reversePredicate)>(
+					m_Animation,
+					std::move(repeatPredicate),
+					std::move(reversePredicate)
+				)
+			);
+		}
+
+		const TAnimation& GetAnimation() const
+		{
+			return m_Animation;
+		}
+
+	private:
+
+		TAnimation m_Animation;
+
+	};
+
+	class InstantAnimation
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InCubic,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseOutCubic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		constexpr InstantAnimation() = default;
+
+		bool IsDone() const
+		{
+			return not (m_DelayInSeconds > 0.0f);
+		}
+
+		void OnDone() const
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return 0;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return 0.0f;
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			if (IsDone())
+			{
+				return deltaTime;
+			}
+
+			m_DelayInSeconds -= deltaTime;
+			return IsDone() ? -m_DelayInSeconds : 0.0f;
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			return IsDone() ? targetValue : initialValue;
+		}
+
+		void Repeat() const
+		{
+		}
+
+		void Reverse() const
+		{
+		}
+
+		void ApplySpeed(float speedFactor)
+		{
+			m_DelayInSeconds /= std::max(speedFactor, 0.0f);
+		}
+
+		void ApplyDelay(float delayInSeconds)
+		{
+			m_DelayInSeconds += delayInSeconds;
+		}
+
+	private:
+
+		float m_DelayInSeconds = 0.0f;
+
+	};
+
+	class NeverAnimation
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::OutCubic,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInOutCubic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		constexpr NeverAnimation() = default;
+
+		bool IsDone() const
+		{
+			return false;
+		}
+
+		void OnDone() const
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return 0;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return std::numeric_limits<float>::infinity();
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			return 0.0f;
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			return initialValue;
+		}
+
+		void Repeat() const
+		{
+		}
+
+		void Reverse() const
+		{
+		}
+
+		void ApplySpeed(float) const
+		{
+		}
+
+		void ApplyDelay(float) const
+		{
+		}
+
+	};
+
+	// Keys for one or more channels; the values of each key are stored next to each other.
+	template <std::size_t TChannels = 1>
+	class BasicCurveAsset
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InOutCubic,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInQuint(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		static_assert(TChannels > 0, "A curve needs at least one channel");
+
+		static constexpr std::size_t Channels = TChannels;
+
+		// Function ranges must hold ease functions; a range of indices selects the constructor below instead.
+		template <std::ranges::range TValues, std::ranges::range TFunctions>
+			requires std::convertible_to<std::ranges::range_value_t<TFunctions>, EaseFunction>
+		BasicCurveAsset(TValues values, TFunctions functions):
+			m_OwnedValues(std::ranges::begin(values), std::ranges::end(values)),
+			m_OwnedFunctions(std::ranges::begin(functions), std::ranges::end(functions)),
+			m_Values(m_OwnedValues),
+			m_Functions(m_OwnedFunctions)
+		{
+		}
+
+		// Timed keys from one duration per segment, in any unit; only their ratios are kept.
+		// Returns null when the number of durations does not match the number of segments.
+		template <std::ranges::range TValues, std::ranges::range TFunctions, std::ranges::range TDurations>
+			requires std::convertible_to<std::ranges::range_value_t<TFunctions>, EaseFunction>
+		static std::shared_ptr<const BasicCurveAsset> Timed(TValues values, TFunctions functions, TDurations segmentDurations)
+		{
+			std::size_t keys = static_cast<std::size_t>(std::ranges::distance(values)) / Channels;
+			if (keys < 2 or static_cast<std::size_t>(std::ranges::distance(segmentDurations)) != keys - 1)
+			{
+				return nullptr;
+			}
+
+			return std::shared_ptr<const BasicCurveAsset>(new BasicCurveAsset(std::move(values), std::move(functions), std::move(segmentDurations)));
+		}
+
+		// References keys owned elsewhere, e.g. in a mapped file; `owner` keeps them alive.
+		BasicCurveAsset(std::span<const float> values, std::span<const std::uint8_t> functionIndices, std::shared_ptr<const void> owner = nullptr):
+			m_Owner(std::move(owner)),
+			m_Values(values),
+			m_FunctionIndices(functionIndices)
+		{
+		}
+
+		BasicCurveAsset(const BasicCurveAsset&) = delete;
+		BasicCurveAsset& operator = (const BasicCurveAsset&) = delete;
+
+		std::span<const float> GetValues() const
+		{
+			return m_Values;
+		}
+
+		std::size_t GetFunctionCount() const
+		{
+			return std::max(m_Functions.size(), m_FunctionIndices.size());
+		}
+
+		EaseFunction GetFunction(std::size_t segment) const
+		{
+			if (not m_FunctionIndices.empty())
+				return ease::Functions[m_FunctionIndices[std::min(segment, m_FunctionIndices.size() - 1)]].Function;
+
+			if (m_Functions.empty())
+				return &ease::Linear;
+
+			return m_Functions[std::min(segment, m_Functions.size() - 1)];
+		}
+
+		// Key times as fractions of the cycle; empty when the keys are evenly spaced.
+		std::span<const float> GetKeyTimes() const
+		{
+			return m_KeyTimes;
+		}
+
+		std::span<const float> GetInverseSegmentLengths() const
+		{
+			return m_InverseSegmentLengths;
+		}
+
+	private:
+
+		template <std::ranges::range TValues, std::ranges::range TFunctions, std::ranges::range TDurations>
+		BasicCurveAsset(TValues values, TFunctions functions, TDurations segmentDurations):
+			BasicCurveAsset(std::move(values), std::move(functions))
+		{
+			float total = 0.0f;
+			for (float duration : segmentDurations)
+			{
+				total += std::max(duration, 0.0f);
+			}
+
+			if (not (total > 0.0f))
+			{
+				return;
+			}
+
+			m_KeyTimes.push_back(0.0f);
+			for (float duration : segmentDurations)
+			{
+				duration = std::max(duration, 0.0f);
+				m_KeyTimes.push_back(m_KeyTimes.back() + duration / total);
+				m_InverseSegmentLengths.push_back(duration > 0.0f ? total / duration : 0.0f);
+			}
+
+			m_KeyTimes.back() = 1.0f;
+		}
+
+		std::vector<float> m_OwnedValues;
+		std::vector<EaseFunction> m_OwnedFunctions;
+		std::vector<float> m_KeyTimes;
+		std::vector<float> m_InverseSegmentLengths;
+		std::shared_ptr<const void> m_Owner;
+
+		std::span<const float> m_Values;
+		std::span<const EaseFunction> m_Functions;
+		std::span<const std::uint8_t> m_FunctionIndices;
+
+	};
+
+	typedef BasicCurveAsset<> CurveAsset;
+
+	template <std::size_t N, std::size_t M = (N > 0 ? N - 1 : 0)>
+	struct FixedCurve
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InQuint,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseOutQuint(float durationInSeconds = TimedAnimation::DefaultDuration)
+		static constexpr std::size_t Channels = 1;
+
+		std::array<float, N> Values;
+		std::array<EaseFunction, M> Functions;
+
+		constexpr std::span<const float, N> GetValues() const
+		{
+			return Values;
+		}
+
+		constexpr std::size_t GetFunctionCount() const
+		{
+			return M;
+		}
+
+		constexpr EaseFunction GetFunction(std::size_t segment) const
+		{
+			if constexpr (M == 0)
+				return &ease::Linear;
+			else
+				return Functions[std::min(segment, M - 1)];
+		}
+
+		constexpr std::span<const float> GetKeyTimes() const
+		{
+			return {};
+		}
+
+		constexpr std::span<const float> GetInverseSegmentLengths() const
+		{
+			return {};
+		}
+	};
+
+	// Non-owning keys, for data that outlives every animation using it.
+	struct CurveView
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::OutQuint,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInOutQuint(float durationInSeconds = TimedAnimation::DefaultDuration)
+		static constexpr std::size_t Channels = 1;
+
+		std::span<const float> Values = {};
+		std::span<const EaseFunction> Functions = {};
+		std::span<const float> KeyTimes = {};
+		std::span<const float> InverseSegmentLengths = {};
+
+		// Timed keys from one duration per segment; only their ratios are kept. The normalized timing
+		// is written to `keyTimes` (one per value) and `inverseSegmentLengths` (one per segment),
+		// which must outlive the view. Returns nullopt when any of the sizes does not match.
+		static constexpr std::optional<CurveView> Timed(
+			std::span<const float> values,
+			std::span<const EaseFunction> functions,
+			std::span<const float> segmentDurations,
+			std::span<float> keyTimes,
+			std::span<float> inverseSegmentLengths
+		)
+		{
+			if (values.size() < 2 or segmentDurations.size() != values.size() - 1 or keyTimes.size() != values.size() or inverseSegmentLengths.size() != values.size() - 1)
+			{
+				return std::nullopt;
+			}
+
+			float total = 0.0f;
+			for (float duration : segmentDurations)
+			{
+				total += std::max(duration, 0.0f);
+			}
+
+			if (not (total > 0.0f))
+			{
+				return CurveView{ values, functions };
+			}
+
+			keyTimes[0] = 0.0f;
+			for (std::size_t segment = 0; segment < segmentDurations.size(); ++segment)
+			{
+				float duration = std::max(segmentDurations[segment], 0.0f);
+				keyTimes[segment + 1] = keyTimes[segment] + duration / total;
+				inverseSegmentLengths[segment] = duration > 0.0f ? total / duration : 0.0f;
+			}
+
+			keyTimes.back() = 1.0f;
+			return CurveView{ values, functions, keyTimes, inverseSegmentLengths };
+		}
+
+		constexpr std::span<const float> GetValues() const
+		{
+			return Values;
+		}
+
+		constexpr std::size_t GetFunctionCount() const
+		{
+			return Functions.size();
+		}
+
+		constexpr EaseFunction GetFunction(std::size_t segment) const
+		{
+			if (Functions.empty())
+				return &ease::Linear;
+
+			return Functions[std::min(segment, Functions.size() - 1)];
+		}
+
+		// Timing that does not cover every key is ignored, so the keys play evenly spaced instead of
+		// being read out of bounds.
+		constexpr std::span<const float> GetKeyTimes() const
+		{
+			return HasValidTiming() ? KeyTimes : std::span<const float>();
+		}
+
+		constexpr std::span<const float> GetInverseSegmentLengths() const
+		{
+			return HasValidTiming() ? InverseSegmentLengths : std::span<const float>();
+		}
+
+		constexpr bool HasValidTiming() const
+		{
+			return Values.size() >= 2 and KeyTimes.size() == Values.size() and InverseSegmentLengths.size() == Values.size() - 1;
+		}
+	};
+
+	template <typename TKeys>
+	struct CurveKeysTraits
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InOutQuint,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInCirc(float durationInSeconds = TimedAnimation::DefaultDuration)
+		typedef TKeys Keys;
+	};
+
+	template <typename TKeys>
+	struct CurveKeysTraits<std::shared_ptr<const TKeys>>
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InCirc,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseOutCirc(float durationInSeconds = TimedAnimation::DefaultDuration)
-	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::OutCirc,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInOutCirc(float durationInSeconds = TimedAnimation::DefaultDuration)
+		typedef TKeys Keys;
+	};
+
+	template <typename TKeys>
+	class BasicTimingCurveAnimation
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InOutCirc,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInElastic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		static constexpr std::size_t Channels = CurveKeysTraits<TKeys>::Keys::Channels;
+
+		template <std::ranges::range TValues, std::ranges::range TFunctions>
+		explicit BasicTimingCurveAnimation(float durationInSeconds, TValues values, TFunctions functions) requires std::is_same_v<TKeys, std::shared_ptr<const BasicCurveAsset<Channels>>>:
+			BasicTimingCurveAnimation(durationInSeconds, std::make_shared<const BasicCurveAsset<Channels>>(std::move(values), std::move(functions)))
+		{
+		}
+
+		explicit constexpr BasicTimingCurveAnimation(float durationInSeconds, TKeys keys):
+			m_Keys(std::move(keys)),
+			m_DurationInSeconds(durationInSeconds)
+		{
+			m_Value = GetValueAt(0);
+			UpdateTimeScale();
+		}
+
+		bool IsDone() const
+		{
+			return m_ValueIndex >= GetValueCount();
+		}
+
+		void OnDone() const
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return 0;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			if (GetValueCount() < 2)
+				return 0.0f;
+
+			if (IsTimed())
+				return m_DurationInSeconds;
+
+			float durationPerValue = m_DurationInSeconds / static_cast<float>(GetValueCount());
+			return durationPerValue * static_cast<float>(GetValueCount() - 1);
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			if (IsDone())
+			{
+				return deltaTime;
+			}
+
+			if (m_DelayInSeconds > 0.0f)
+			{
+				m_DelayInSeconds -= deltaTime;
+				if (m_DelayInSeconds > 0.0f)
+				{
+					return 0.0f;
+				}
+
+				deltaTime = -m_DelayInSeconds;
+				m_DelayInSeconds = 0.0f;
+			}
+
+			if (not (m_DurationInSeconds > 0.0f))
+			{
+				m_ValueIndex = GetValueCount();
+				m_Value = GetTargetValue();
+				return std::max(deltaTime, 0.0f);
+			}
+
+			float position = std::max(m_Position + deltaTime * m_TimeScale, 0.0f);
+
+			while (not IsDone() and position >= GetSegmentLength())
+			{
+				position -= GetSegmentLength();
+				++m_ValueIndex;
+			}
+
+			if (IsDone())
+			{
+				m_Position = 0.0f;
+				m_Value = GetTargetValue();
+				return m_TimeScale > 0.0f ? position / m_TimeScale : 0.0f;
+			}
+
+			m_Position = position;
+
+			// The segment and its ease are shared by every channel.
+			float progress = GetFunction()(m_Position * GetInverseSegmentLength());
+			std::array<float, Channels> previousTarget = GetPreviousTargetValue();
+			std::array<float, Channels> target = GetTargetValue();
+
+			for (std::size_t channel = 0; channel < Channels; ++channel)
+			{
+				m_Value[channel] = std::lerp(previousTarget[channel], target[channel], progress);
+			}
+
+			return 0.0f;
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			// A folded delay holds the initial value, as DelayAnimationDecorator does.
+			if (m_DelayInSeconds > 0.0f)
+			{
+				return initialValue;
+			}
+
+			if constexpr (Channels == 1)
+			{
+				return initialValue + (targetValue - initialValue) * m_Value[0];
+			}
+			else
+			{
+				// Channel i drives component i, so T must be indexable like std::array<float, Channels>.
+				T value = initialValue;
+				for (std::size_t channel = 0; channel < Channels; ++channel)
+				{
+					value[channel] = initialValue[channel] + (targetValue[channel] - initialValue[channel]) * m_Value[channel];
+				}
+
+				return value;
+			}
+		}
+
+		void Repeat()
+		{
+			m_ValueIndex = 1;
+		}
+
+		void Reverse()
+		{
+			m_Forward = not m_Forward;
+		}
+
+		void ApplySpeed(float speedFactor)
+		{
+			m_DurationInSeconds /= std::max(speedFactor, 0.0f);
+			m_DelayInSeconds /= std::max(speedFactor, 0.0f);
+			UpdateTimeScale();
+		}
+
+		void ApplyDelay(float delayInSeconds)
+		{
+			m_DelayInSeconds += delayInSeconds;
+		}
+
+		const TKeys& GetCurve() const
+		{
+			return m_Keys;
+		}
+
+	private:
+
+		friend class AnimationPlan;
+
+		constexpr const auto& GetKeys() const
+		{
+			if constexpr (requires { *m_Keys; })
+				return *m_Keys;
+			else
+				return m_Keys;
+		}
+
+		// Number of keys; each key holds one value per channel.
+		constexpr std::size_t GetValueCount() const
+		{
+			return GetKeys().GetValues().size() / Channels;
+		}
+
+		constexpr bool IsTimed() const
+		{
+			return not GetKeys().GetKeyTimes().empty();
+		}
+
+		// Time is measured in segments for evenly spaced keys and in cycles for timed keys.
+		constexpr void UpdateTimeScale()
+		{
+			float units = IsTimed() ? 1.0f : static_cast<float>(GetValueCount());
+			m_TimeScale = m_DurationInSeconds > 0.0f ? units / m_DurationInSeconds : 0.0f;
+		}
+
+		std::size_t GetKeySegment() const
+		{
+			std::size_t segment = m_ValueIndex - 1;
+			return m_Forward ? segment : GetValueCount() - 2 - segment;
+		}
+
+		float GetSegmentLength() const
+		{
+			if (not IsTimed())
+				return 1.0f;
+
+			std::span<const float> times = GetKeys().GetKeyTimes();
+			std::size_t segment = GetKeySegment();
+			return times[segment + 1] - times[segment];
+		}
+
+		float GetInverseSegmentLength() const
+		{
+			if (not IsTimed())
+				return 1.0f;
+
+			return GetKeys().GetInverseSegmentLengths()[GetKeySegment()];
+		}
+
+		// A reversed curve walks the shared keys from the back instead of reordering them.
+		constexpr std::array<float, Channels> GetValueAt(std::size_t index) const
+		{
+			std::array<float, Channels> value = {};
+
+			std::size_t count = GetValueCount();
+			if (count == 0)
+				return value;
+
+			index = std::min(index, count - 1);
+			index = m_Forward ? index : count - 1 - index;
+
+			auto values = GetKeys().GetValues();
+			for (std::size_t channel = 0; channel < Channels; ++channel)
+			{
+				value[channel] = values[index * Channels + channel];
+			}
+
+			return value;
+		}
+
+		std::array<float, Channels> GetPreviousTargetValue() const
+		{
+			return GetValueAt(m_ValueIndex - 1);
+		}
+
+		std::array<float, Channels> GetTargetValue() const
+		{
+			return GetValueAt(m_ValueIndex);
+		}
+
+		EaseFunction GetFunction() const
+		{
+			std::size_t functionCount = GetKeys().GetFunctionCount();
+			if (functionCount == 0)
+				return &ease::Linear;
+
+			std::size_t segment = std::min(m_ValueIndex - 1, functionCount - 1);
+			return GetKeys().GetFunction(m_Forward ? segment : functionCount - 1 - segment);
+		}
+
+		TKeys m_Keys;
+
+		float m_Position = 0.0f;
+		float m_TimeScale = 0.0f;
+		float m_DurationInSeconds;
+		float m_DelayInSeconds = 0.0f;
+		std::size_t m_ValueIndex = 1;
+		std::array<float, Channels> m_Value = {};
+		bool m_Forward = true;
+
+	};
+
+	typedef BasicTimingCurveAnimation<std::shared_ptr<const CurveAsset>> TimingCurveAnimation;
+
+	template <std::size_t TChannels>
+	using ChannelTimingCurveAnimation = BasicTimingCurveAnimation<std::shared_ptr<const BasicCurveAsset<TChannels>>>;
+
+	// A chain of cubic segments with a table that maps distance along the path back to the
+	// spline parameter, so points can be looked up by distance traveled.
+	template <typename TPoint>
+	class PathAsset
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::InElastic,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseOutElastic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		inline static constexpr std::size_t DefaultSamplesPerSegment = 16;
+
+		// Passes through every point; the first and last points are repeated as outer neighbours.
+		template <std::ranges::range TPoints>
+		static PathAsset CatmullRom(const TPoints& points, std::size_t samplesPerSegment = DefaultSamplesPerSegment)
+		{
+			std::vector<TPoint> p(std::ranges::begin(points), std::ranges::end(points));
+
+			PathAsset path;
+			for (std::size_t i = 0; i + 1 < p.size(); ++i)
+			{
+				const TPoint& p0 = p[i > 0 ? i - 1 : i];
+				const TPoint& p1 = p[i];
+				const TPoint& p2 = p[i + 1];
+				const TPoint& p3 = p[i + 2 < p.size() ? i + 2 : i + 1];
+
+				path.m_Segments.push_back({
+					(p1 - p2) * 1.5f + (p3 - p0) * 0.5f,
+					(p0 - p1) + (p2 - p1) * 2.0f + (p1 - p3) * 0.5f,
+					(p2 - p0) * 0.5f,
+					p1
+				});
+			}
+
+			path.Build(p, samplesPerSegment);
+			return path;
+		}
+
+		// Takes 3n + 1 points: each segment uses the previous segment's end point and three new ones.
+		template <std::ranges::range TPoints>
+		static PathAsset CubicBezier(const TPoints& points, std::size_t samplesPerSegment = DefaultSamplesPerSegment)
+		{
+			std::vector<TPoint> p(std::ranges::begin(points), std::ranges::end(points));
+
+			PathAsset path;
+			for (std::size_t i = 0; i + 3 < p.size(); i += 3)
+			{
+				path.m_Segments.push_back({
+					(p[i + 3] - p[i]) + (p[i + 1] - p[i + 2]) * 3.0f,
+					(p[i] - p[i + 1]) * 3.0f + (p[i + 2] - p[i + 1]) * 3.0f,
+					(p[i + 1] - p[i]) * 3.0f,
+					p[i]
+				});
+			}
+
+			path.Build(p, samplesPerSegment);
+			return path;
+		}
+
+		float GetLength() const
+		{
+			return m_Length;
+		}
+
+		std::size_t GetSegmentCount() const
+		{
+			return m_Segments.size();
+		}
+
+		// `fraction` is the share of the length traveled; values outside [0, 1] extend the end segments.
+		TPoint GetPointAt(float fraction) const
+		{
+			if (m_Segments.empty())
+				return TPoint{};
+
+			float position = fraction * static_cast<float>(m_Parameters.size() - 1);
+			float index = std::clamp(std::floor(position), 0.0f, static_cast<float>(m_Parameters.size() - 2));
+
+			std::size_t entry = static_cast<std::size_t>(index);
+			return Evaluate(std::lerp(m_Parameters[entry], m_Parameters[entry + 1], position - index));
+		}
+
+	private:
+
+		// P(t) = ((A * t + B) * t + C) * t + D
+		struct Segment
+		{
+			TPoint A;
+			TPoint B;
+			TPoint C;
+			TPoint D;
+		};
+
+		PathAsset() = default;
+
+		static float Measure(const TPoint& delta)
+		{
+			if constexpr (std::is_arithmetic_v<TPoint>)
+				return std::abs(static_cast<float>(delta));
+			else if constexpr (requires { delta.Length(); })
+				return static_cast<float>(delta.Length());
+			else if constexpr (requires { Length(delta); })
+				return static_cast<float>(Length(delta));
+			else if constexpr (requires { length(delta); })
+				return static_cast<float>(length(delta));
+			else
+				static_assert(std::is_arithmetic_v<TPoint>, "path points need a Length() member or a Length/length function found by ADL");
+		}
+
+		TPoint Evaluate(float parameter) const
+		{
+			float index = std::clamp(std::floor(parameter), 0.0f, static_cast<float>(m_Segments.size() - 1));
+			float t = parameter - index;
+
+			const Segment& segment = m_Segments[static_cast<std::size_t>(index)];
+			return ((segment.A * t + segment.B) * t + segment.C) * t + segment.D;
+		}
+
+		void Build(const std::vector<TPoint>& points, std::size_t samplesPerSegment)
+		{
+			if (m_Segments.empty())
+			{
+				if (points.empty())
+					return;
+
+				TPoint zero = points.front() - points.front();
+				m_Segments.push_back({ zero, zero, zero, points.front() });
+			}
+
+			// Integrate with finer steps than the table stores, then invert at even distances.
+			constexpr std::size_t Substeps = 8;
+
+			float segments = static_cast<float>(m_Segments.size());
+			std::size_t entries = m_Segments.size() * std::max<std::size_t>(samplesPerSegment, 1);
+			std::size_t steps = entries * Substeps;
+			float parameterPerStep = segments / static_cast<float>(steps);
+
+			std::vector<float> distances(steps + 1, 0.0f);
+			TPoint previous = Evaluate(0.0f);
+			for (std::size_t i = 1; i <= steps; ++i)
+			{
+				TPoint point = Evaluate(static_cast<float>(i) * parameterPerStep);
+				distances[i] = distances[i - 1] + Measure(point - previous);
+				previous = point;
+			}
+
+			m_Length = distances.back();
+			m_Parameters.resize(entries + 1);
+
+			std::size_t step = 0;
+			for (std::size_t i = 0; i <= entries; ++i)
+			{
+				float fraction = static_cast<float>(i) / static_cast<float>(entries);
+				if (not (m_Length > 0.0f))
+				{
+					m_Parameters[i] = fraction * segments;
+					continue;
+				}
+
+				float distance = fraction * m_Length;
+				while (step + 1 < steps and distances[step + 1] < distance)
+				{
+					++step;
+				}
+
+				float stepLength = distances[step + 1] - distances[step];
+				float t = stepLength > 0.0f ? std::clamp((distance - distances[step]) / stepLength, 0.0f, 1.0f) : 0.0f;
+				m_Parameters[i] = (static_cast<float>(step) + t) * parameterPerStep;
+			}
+
+			m_Parameters.back() = segments;
+		}
+
+		std::vector<Segment> m_Segments;
+		std::vector<float> m_Parameters;
+		float m_Length = 0.0f;
+
+	};
+
+	// Moves along a path at constant speed; the ease shapes the distance traveled over time.
+	// The value is the point on the path, so the initial and target values are not used.
+	template <typename TPoint>
+	class PathAnimation
 	{
-		return AnimationBuilder(
-			TimedAnimation(
-				&ease::OutElastic,
-				durationInSeconds
-			)
-		);
-	}
-	constexpr AnimationBuilder<TimedAnimation> EaseInOutElastic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	public:
+
+		explicit PathAnimation(std::shared_ptr<const PathAsset<TPoint>> path, float durationInSeconds, EaseFunction ease = &ease::Linear):
+			m_Path(std::move(path)),
+			m_Timing(ease, durationInSeconds),
+			m_Point(m_Path->GetPointAt(0.0f))
+		{
+		}
+
+		bool IsDone() const
+		{
+			return m_Timing.IsDone();
+		}
+
+		void OnDone()
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return 0;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return m_Timing.GetCycleDurationInSeconds();
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			float remainingTime = m_Timing.Update(0.0f, 1.0f, 0.0f, deltaTime);
+			m_Point = m_Path->GetPointAt(m_Timing.GetValue(0.0f, 1.0f, 0.0f));
+			return remainingTime;
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			return m_Point;
+		}
+
+		void Reverse()
+		{
+			m_Timing.Reverse();
+		}
+
+		void Repeat()
+		{
+			m_Timing.Repeat();
+		}
+
+		void ApplySpeed(float speedFactor)
+		{
+			m_Timing.ApplySpeed(speedFactor);
+		}
+
+		void ApplyDelay(float delayInSeconds)
+		{
+			m_Timing.ApplyDelay(delayInSeconds);
+		}
+
+		const std::shared_ptr<const PathAsset<TPoint>>& GetPath() const
+		{
+			return m_Path;
+		}
+
+	private:
+
+		std::shared_ptr<const PathAsset<TPoint>> m_Path;
+		TimedAnimation m_Timing;
+		TPoint m_Point;
+
+	};
+
+	constexpr AnimationBuilder<TimedAnimation> EaseLinear(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::Linear,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInSine(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InSine,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseOutSine(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::OutSine,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInOutSine(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InOutSine,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInCubic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InCubic,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseOutCubic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::OutCubic,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInOutCubic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InOutCubic,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInQuint(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InQuint,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseOutQuint(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::OutQuint,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInOutQuint(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InOutQuint,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInCirc(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InCirc,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseOutCirc(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::OutCirc,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInOutCirc(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InOutCirc,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInElastic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::InElastic,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseOutElastic(float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			TimedAnimation(
+				&ease::OutElastic,
+				durationInSeconds
+			)
+		);
+	}
+	constexpr AnimationBuilder<TimedAnimation> EaseInOutElastic(float durationInSeconds = TimedAnimation::DefaultDuration)
 	{
 		return AnimationBuilder(
 			TimedAnimation(
@@ -979,6 +2546,16 @@ namespace ui
 			)
 		);
 	}
+	template <ease::EaseCurve TCurve>
+	constexpr AnimationBuilder<BasicTimedAnimation<TCurve>> Ease(TCurve curve, float durationInSeconds = TimedAnimation::DefaultDuration)
+	{
+		return AnimationBuilder(
+			BasicTimedAnimation<TCurve>(
+				std::move(curve),
+				durationInSeconds
+			)
+		);
+	}
 	constexpr AnimationBuilder<InstantAnimation> Instant()
 	{
 		return AnimationBuilder(InstantAnimation());
@@ -988,143 +2565,3188 @@ namespace ui
 		return AnimationBuilder(NeverAnimation());
 	}
 
-	template <std::ranges::range TValues, std::ranges::range TFunctions>
-	constexpr AnimationBuilder<TimingCurveAnimation> TimingCurve(
-		float durationInSeconds,
-		TValues values,
-		TFunctions functions
-	)
-	{
-		return AnimationBuilder<TimingCurveAnimation>(
-			TimingCurveAnimation(
-				durationInSeconds,
-				std::move(values),
-				std::move(functions)
-			)
-		);
-	}
-	
-	
-	template <typename T>
-	class Animatable
+	template <std::ranges::range TValues, std::ranges::range TFunctions>
+	AnimationBuilder<TimingCurveAnimation> TimingCurve(
+		float durationInSeconds,
+		TValues values,
+		TFunctions functions
+	)
+	{
+		return AnimationBuilder<TimingCurveAnimation>(
+			TimingCurveAnimation(
+				durationInSeconds,
+				std::move(values),
+				std::move(functions)
+			)
+		);
+	}
+
+	inline AnimationBuilder<TimingCurveAnimation> TimingCurve(float durationInSeconds, std::shared_ptr<const CurveAsset> curve)
+	{
+		return AnimationBuilder<TimingCurveAnimation>(
+			TimingCurveAnimation(durationInSeconds, std::move(curve))
+		);
+	}
+
+	// Returns nullopt when the number of durations does not match the number of segments.
+	template <std::ranges::range TValues, std::ranges::range TFunctions, std::ranges::range TDurations>
+	std::optional<AnimationBuilder<TimingCurveAnimation>> TimingCurve(
+		TValues values,
+		TFunctions functions,
+		TDurations segmentDurationsInSeconds
+	)
+	{
+		float durationInSeconds = 0.0f;
+		for (float duration : segmentDurationsInSeconds)
+		{
+			durationInSeconds += std::max(duration, 0.0f);
+		}
+
+		std::shared_ptr<const CurveAsset> curve = CurveAsset::Timed(std::move(values), std::move(functions), std::move(segmentDurationsInSeconds));
+		if (curve == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		return TimingCurve(durationInSeconds, std::move(curve));
+	}
+
+	// `values` holds TChannels values per key, e.g. { x0, y0, a0, x1, y1, a1, ... }.
+	template <std::size_t TChannels, std::ranges::range TValues, std::ranges::range TFunctions>
+	AnimationBuilder<ChannelTimingCurveAnimation<TChannels>> ChannelTimingCurve(
+		float durationInSeconds,
+		TValues values,
+		TFunctions functions
+	)
+	{
+		return AnimationBuilder<ChannelTimingCurveAnimation<TChannels>>(
+			ChannelTimingCurveAnimation<TChannels>(
+				durationInSeconds,
+				std::move(values),
+				std::move(functions)
+			)
+		);
+	}
+
+	template <std::size_t TChannels>
+	AnimationBuilder<ChannelTimingCurveAnimation<TChannels>> ChannelTimingCurve(float durationInSeconds, std::shared_ptr<const BasicCurveAsset<TChannels>> curve)
+	{
+		return AnimationBuilder<ChannelTimingCurveAnimation<TChannels>>(
+			ChannelTimingCurveAnimation<TChannels>(durationInSeconds, std::move(curve))
+		);
+	}
+
+	// Returns nullopt when the number of durations does not match the number of segments.
+	template <std::size_t TChannels, std::ranges::range TValues, std::ranges::range TFunctions, std::ranges::range TDurations>
+	std::optional<AnimationBuilder<ChannelTimingCurveAnimation<TChannels>>> ChannelTimingCurve(
+		TValues values,
+		TFunctions functions,
+		TDurations segmentDurationsInSeconds
+	)
+	{
+		float durationInSeconds = 0.0f;
+		for (float duration : segmentDurationsInSeconds)
+		{
+			durationInSeconds += std::max(duration, 0.0f);
+		}
+
+		std::shared_ptr<const BasicCurveAsset<TChannels>> curve = BasicCurveAsset<TChannels>::Timed(std::move(values), std::move(functions), std::move(segmentDurationsInSeconds));
+		if (curve == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		return ChannelTimingCurve<TChannels>(durationInSeconds, std::move(curve));
+	}
+
+	template <std::size_t N, std::size_t M>
+	constexpr AnimationBuilder<BasicTimingCurveAnimation<FixedCurve<N, M>>> TimingCurve(
+		float durationInSeconds,
+		const std::array<float, N>& values,
+		const std::array<EaseFunction, M>& functions
+	)
+	{
+		return AnimationBuilder<BasicTimingCurveAnimation<FixedCurve<N, M>>>(
+			BasicTimingCurveAnimation<FixedCurve<N, M>>(durationInSeconds, FixedCurve<N, M>{ values, functions })
+		);
+	}
+
+	constexpr AnimationBuilder<BasicTimingCurveAnimation<CurveView>> TimingCurve(
+		float durationInSeconds,
+		std::span<const float> values,
+		std::span<const EaseFunction> functions
+	)
+	{
+		return AnimationBuilder<BasicTimingCurveAnimation<CurveView>>(
+			BasicTimingCurveAnimation<CurveView>(durationInSeconds, CurveView{ values, functions })
+		);
+	}
+
+	constexpr AnimationBuilder<BasicTimingCurveAnimation<CurveView>> TimingCurve(float durationInSeconds, const CurveView& curve)
+	{
+		return AnimationBuilder<BasicTimingCurveAnimation<CurveView>>(
+			BasicTimingCurveAnimation<CurveView>(durationInSeconds, curve)
+		);
+	}
+
+	template <typename TPoint>
+	AnimationBuilder<PathAnimation<TPoint>> FollowPath(float durationInSeconds, std::shared_ptr<const PathAsset<TPoint>> path, EaseFunction ease = &ease::Linear)
+	{
+		return AnimationBuilder<PathAnimation<TPoint>>(
+			PathAnimation<TPoint>(std::move(path), durationInSeconds, ease)
+		);
+	}
+
+	template <std::ranges::range TPoints>
+	AnimationBuilder<PathAnimation<std::ranges::range_value_t<TPoints>>> CatmullRomPath(float durationInSeconds, const TPoints& points, EaseFunction ease = &ease::Linear)
+	{
+		typedef std::ranges::range_value_t<TPoints> TPoint;
+		return FollowPath(durationInSeconds, std::make_shared<const PathAsset<TPoint>>(PathAsset<TPoint>::CatmullRom(points)), ease);
+	}
+
+	template <std::ranges::range TPoints>
+	AnimationBuilder<PathAnimation<std::ranges::range_value_t<TPoints>>> BezierPath(float durationInSeconds, const TPoints& points, EaseFunction ease = &ease::Linear)
+	{
+		typedef std::ranges::range_value_t<TPoints> TPoint;
+		return FollowPath(durationInSeconds, std::make_shared<const PathAsset<TPoint>>(PathAsset<TPoint>::CubicBezier(points)), ease);
+	}
+
+	class AnimationPlan
+	{
+	public:
+
+		template <typename TAnimation>
+		explicit AnimationPlan(const TAnimation& animation)
+		{
+			Lower(animation, 1.0);
+
+			if (not (m_CycleDurationInSeconds > 0.0))
+			{
+				m_CycleDurationInSeconds = 0.0;
+				m_RepeatCount = 0;
+			}
+
+			m_InverseCycleDuration = m_CycleDurationInSeconds > 0.0 ? 1.0 / m_CycleDurationInSeconds : 0.0;
+			m_TotalDurationInSeconds = m_RepeatCount == std::numeric_limits<std::size_t>::max()
+				? std::numeric_limits<double>::infinity()
+				: m_CycleDurationInSeconds * static_cast<double>(m_RepeatCount + 1);
+
+			Seek();
+		}
+
+		bool IsDone() const
+		{
+			return m_Done;
+		}
+
+		void OnDone() const
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return m_LoopCount;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return static_cast<float>(m_TotalDurationInSeconds / m_TimeScale);
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			return Update(initialValue, targetValue, currentValue, ToTicks(deltaTime));
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, Ticks deltaTime)
+		{
+			m_ElapsedTime += deltaTime;
+
+			// Within one segment of one cycle the curve input is linear in the elapsed ticks;
+			// Seek runs once per segment to set that up, or once when the plan starts or ends.
+			if (m_ElapsedTime >= m_SegmentEnd)
+			{
+				return Seek();
+			}
+
+			if (m_ElapsedTime >= m_SegmentStart)
+			{
+				float x = m_SegmentOrigin + static_cast<float>(static_cast<double>((m_ElapsedTime - m_SegmentStart).count()) * m_SegmentSlopePerTick);
+				m_Progress = m_SegmentFrom + m_SegmentDelta * ApplyEase(m_SegmentEase, std::clamp(x, 0.0f, 1.0f));
+			}
+
+			return 0.0f;
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			return initialValue + (targetValue - initialValue) * m_Progress;
+		}
+
+		float GetProgressAt(double elapsedTimeInSeconds) const
+		{
+			Cycle cycle = FindCycle((elapsedTimeInSeconds - m_StartOffsetInSeconds) * m_TimeScale);
+			return cycle.Index == NotStarted ? 0.0f : Evaluate(cycle.Phase, cycle.Forward);
+		}
+
+		bool IsDoneAt(double elapsedTimeInSeconds) const
+		{
+			return (elapsedTimeInSeconds - m_StartOffsetInSeconds) * m_TimeScale >= m_TotalDurationInSeconds;
+		}
+
+		void Repeat()
+		{
+			m_ElapsedTime = ToTicks(m_StartOffsetInSeconds);
+			Seek();
+		}
+
+		void Reverse()
+		{
+			m_Forward = not m_Forward;
+			Seek();
+		}
+
+		void ApplySpeed(float speedFactor)
+		{
+			if (speedFactor > 0.0f)
+			{
+				m_StartOffsetInSeconds /= speedFactor;
+				m_TimeScale *= speedFactor;
+			}
+			else
+			{
+				m_TimeScale = 0.0;
+			}
+
+			Seek();
+		}
+
+		void ApplyDelay(float delayInSeconds)
+		{
+			m_StartOffsetInSeconds += delayInSeconds;
+			Seek();
+		}
+
+	private:
+
+		inline static constexpr std::size_t NotStarted = std::numeric_limits<std::size_t>::max();
+
+		struct Cycle
+		{
+			std::size_t Index;
+			double Phase;
+			double StartInSeconds;
+			bool Forward;
+		};
+
+		// A stretch of the cycle, in play order, over which one ease maps `From` to `To`:
+		// the ease input is Origin + (phase - Begin) * Slope.
+		struct Segment
+		{
+			double Begin;
+			double End;
+			float Origin;
+			float Slope;
+			float From;
+			float To;
+			EaseFunction Ease;
+		};
+
+		Cycle FindCycle(double localTime) const
+		{
+			if (not (localTime >= 0.0))
+			{
+				return { NotStarted, 0.0, 0.0, m_Forward };
+			}
+
+			std::size_t index = m_RepeatCount;
+			double phase = 1.0;
+			double start = m_TotalDurationInSeconds - m_CycleDurationInSeconds;
+
+			if (localTime < m_TotalDurationInSeconds)
+			{
+				// Whole cycles are counted in double and the remainder corrected by one cycle if the
+				// division rounded across a boundary, so the phase stays exact to within one rounding
+				// of the elapsed time however many cycles have passed.
+				double cycles = std::floor(localTime * m_InverseCycleDuration);
+				double time = localTime - cycles * m_CycleDurationInSeconds;
+
+				if (time < 0.0)
+				{
+					cycles -= 1.0;
+					time += m_CycleDurationInSeconds;
+				}
+				else if (time >= m_CycleDurationInSeconds)
+				{
+					cycles += 1.0;
+					time -= m_CycleDurationInSeconds;
+				}
+
+				index = cycles < static_cast<double>(m_RepeatCount) ? static_cast<std::size_t>(cycles) : m_RepeatCount;
+				phase = std::clamp(time * m_InverseCycleDuration, 0.0, 1.0);
+				start = cycles * m_CycleDurationInSeconds;
+			}
+
+			std::size_t reverses = std::min(index, m_ReverseCount);
+			return { index, phase, start, m_Forward == (reverses % 2 == 0) };
+		}
+
+		float Seek()
+		{
+			double localTime = (ToSeconds(m_ElapsedTime) - m_StartOffsetInSeconds) * m_TimeScale;
+			Cycle cycle = FindCycle(localTime);
+
+			m_Done = localTime >= m_TotalDurationInSeconds;
+
+			if (cycle.Index == NotStarted)
+			{
+				m_LoopCount = 0;
+				m_Progress = 0.0f;
+				m_SegmentStart = m_SegmentEnd = m_TimeScale > 0.0 ? ToTicks(m_StartOffsetInSeconds) : Ticks::max();
+				return 0.0f;
+			}
+
+			Segment segment = FindSegment(cycle.Phase, cycle.Forward);
+			m_LoopCount = cycle.Index;
+			m_Progress = Evaluate(segment, cycle.Phase);
+
+			if (m_Done)
+			{
+				m_SegmentStart = m_SegmentEnd = Ticks::min();
+				return m_TimeScale > 0.0 ? static_cast<float>((localTime - m_TotalDurationInSeconds) / m_TimeScale) : 0.0f;
+			}
+
+			if (not (m_TimeScale > 0.0))
+			{
+				m_SegmentStart = m_SegmentEnd = Ticks::max();
+				return 0.0f;
+			}
+
+			double cycleDuration = m_CycleDurationInSeconds / m_TimeScale;
+			double cycleStart = m_StartOffsetInSeconds + cycle.StartInSeconds / m_TimeScale;
+
+			m_SegmentStart = ToTicks(cycleStart + segment.Begin * cycleDuration);
+			m_SegmentEnd = ToTicks(cycleStart + segment.End * cycleDuration);
+			m_SegmentSlopePerTick = segment.Slope / (cycleDuration * Ticks::period::den);
+			m_SegmentOrigin = segment.Origin;
+			m_SegmentFrom = segment.From;
+			m_SegmentDelta = segment.To - segment.From;
+			m_SegmentEase = segment.Ease;
+
+			return 0.0f;
+		}
+
+		template <bool TInRepeat = false, typename TCurve>
+		void Lower(const BasicTimedAnimation<TCurve>& animation, double timeScale)
+		{
+			if constexpr (std::is_same_v<TCurve, EaseFunction>)
+			{
+				m_Ease = animation.m_Ease;
+			}
+			else
+			{
+				m_CurveObject = std::make_shared<const TCurve>(animation.m_Ease);
+				m_CurveFunction = [](const void* curve, float x) -> float
+				{
+					return (*static_cast<const TCurve*>(curve))(x);
+				};
+			}
+
+			m_Forward = animation.m_Forward;
+			m_CycleDurationInSeconds = animation.m_DurationInSeconds;
+			m_TimeScale = timeScale;
+
+			if (animation.m_ElapsedTimeInSeconds < 0.0f and timeScale > 0.0f)
+			{
+				m_StartOffsetInSeconds -= static_cast<double>(animation.m_ElapsedTimeInSeconds) / timeScale;
+			}
+		}
+
+		template <bool TInRepeat = false, typename TKeys>
+		void Lower(const BasicTimingCurveAnimation<TKeys>& animation, double timeScale)
+		{
+			static_assert(BasicTimingCurveAnimation<TKeys>::Channels == 1, "AnimationPlan supports single-channel curves");
+
+			if constexpr (std::is_same_v<TKeys, std::shared_ptr<const CurveAsset>>)
+			{
+				m_Curve = animation.m_Keys;
+			}
+			else
+			{
+				const auto& keys = animation.GetKeys();
+
+				std::vector<EaseFunction> functions;
+				for (std::size_t i = 0; i < keys.GetFunctionCount(); ++i)
+				{
+					functions.push_back(keys.GetFunction(i));
+				}
+
+				std::span<const float> times = keys.GetKeyTimes();
+				if (times.empty())
+				{
+					m_Curve = std::make_shared<const CurveAsset>(keys.GetValues(), std::move(functions));
+				}
+				else
+				{
+					std::vector<float> durations;
+					for (std::size_t i = 1; i < times.size(); ++i)
+					{
+						durations.push_back(times[i] - times[i - 1]);
+					}
+
+					m_Curve = CurveAsset::Timed(keys.GetValues(), std::move(functions), std::move(durations));
+				}
+			}
+
+			m_Forward = animation.m_Forward;
+			m_CycleDurationInSeconds = animation.GetCycleDurationInSeconds();
+			m_TimeScale = timeScale;
+
+			if (animation.m_DelayInSeconds > 0.0f and timeScale > 0.0f)
+			{
+				m_StartOffsetInSeconds += static_cast<double>(animation.m_DelayInSeconds) / timeScale;
+			}
+		}
+
+		template <bool TInRepeat = false, typename TAnimation>
+		void Lower(const DelayAnimationDecorator<TAnimation>& animation, double timeScale)
+		{
+			if (animation.IsWaiting() and timeScale > 0.0f)
+			{
+				m_StartOffsetInSeconds += static_cast<double>(animation.m_DelayInSeconds) / timeScale;
+			}
+
+			Lower<TInRepeat>(animation.m_Animation, timeScale);
+		}
+
+		template <bool TInRepeat = false, typename TAnimation>
+		void Lower(const SpeedAnimationDecorator<TAnimation>& animation, double timeScale)
+		{
+			Lower<TInRepeat>(animation.m_Animation, timeScale * animation.m_SpeedFactor);
+		}
+
+		template <bool TInRepeat = false, typename TAnimation, typename TRepeatPredicate, typename TReversePredicate>
+		void Lower(const RepeatAnimationDecorator<TAnimation, TRepeatPredicate, TReversePredicate>& animation, double timeScale)
+		{
+			static_assert(not TInRepeat, "AnimationPlan supports a single Repeat per chain");
+
+			m_RepeatCount = animation.m_Exhausted ? 0 : CountOf(animation.m_RepeatPredicate);
+			m_ReverseCount = CountOf(animation.m_ReversePredicate);
+
+			Lower<true>(animation.m_Animation, timeScale);
+		}
+
+		static std::size_t CountOf(const Predicate::AlwaysType&)
+		{
+			return std::numeric_limits<std::size_t>::max();
+		}
+
+		static std::size_t CountOf(const Predicate::NeverType&)
+		{
+			return 0;
+		}
+
+		static std::size_t CountOf(const Predicate::Countdown& predicate)
+		{
+			return predicate.GetRemaining();
+		}
+
+		Segment FindSegment(double phase, bool forward) const
+		{
+			if (m_Curve == nullptr)
+			{
+				return { 0.0, 1.0, forward ? 0.0f : 1.0f, forward ? 1.0f : -1.0f, 0.0f, 1.0f, m_Ease };
+			}
+
+			std::span<const float> values = m_Curve->GetValues();
+			std::span<const float> times = m_Curve->GetKeyTimes();
+			std::size_t functionCount = m_Curve->GetFunctionCount();
+
+			if (values.size() < 2)
+			{
+				float value = values.empty() ? 0.0f : values.front();
+				return { 0.0, 1.0, 0.0f, 0.0f, value, value, &ease::Linear };
+			}
+
+			std::size_t segments = values.size() - 1;
+			std::size_t segment = 0;
+			double begin = 0.0;
+			double end = 1.0;
+
+			if (times.empty())
+			{
+				segment = std::min(static_cast<std::size_t>(phase * static_cast<double>(segments)), segments - 1);
+				begin = static_cast<double>(segment) / static_cast<double>(segments);
+				end = static_cast<double>(segment + 1) / static_cast<double>(segments);
+			}
+			else
+			{
+				// Timed keys are located on the forward timeline, then mirrored back into play order.
+				float position = static_cast<float>(forward ? phase : 1.0 - phase);
+				std::size_t key = static_cast<std::size_t>(std::ranges::upper_bound(times, position) - times.begin());
+				key = std::clamp<std::size_t>(key, 1, segments) - 1;
+
+				segment = forward ? key : segments - 1 - key;
+				begin = forward ? times[key] : 1.0 - times[key + 1];
+				end = forward ? times[key + 1] : 1.0 - times[key];
+			}
+
+			std::size_t from = forward ? segment : segments - segment;
+			std::size_t to = forward ? from + 1 : from - 1;
+
+			EaseFunction ease = &ease::Linear;
+			if (functionCount > 0)
+			{
+				std::size_t function = std::min(segment, functionCount - 1);
+				ease = m_Curve->GetFunction(forward ? function : functionCount - 1 - function);
+			}
+
+			float slope = end > begin ? static_cast<float>(1.0 / (end - begin)) : 0.0f;
+			return { begin, end, 0.0f, slope, values[from], values[to], ease };
+		}
+
+		float Evaluate(double phase, bool forward) const
+		{
+			return Evaluate(FindSegment(phase, forward), phase);
+		}
+
+		float Evaluate(const Segment& segment, double phase) const
+		{
+			float x = segment.Origin + static_cast<float>(phase - segment.Begin) * segment.Slope;
+			return segment.From + (segment.To - segment.From) * ApplyEase(segment.Ease, std::clamp(x, 0.0f, 1.0f));
+		}
+
+		float ApplyEase(EaseFunction ease, float x) const
+		{
+			return m_CurveFunction == nullptr ? ease(x) : m_CurveFunction(m_CurveObject.get(), x);
+		}
+
+		// Everything Update touches between two Seeks comes first, within one cache line.
+		Ticks m_ElapsedTime{};
+		Ticks m_SegmentStart{};
+		Ticks m_SegmentEnd{};
+		double m_SegmentSlopePerTick = 0.0;
+		float m_SegmentOrigin = 0.0f;
+		float m_SegmentFrom = 0.0f;
+		float m_SegmentDelta = 0.0f;
+		float m_Progress = 0.0f;
+		EaseFunction m_SegmentEase = &ease::Linear;
+		float(*m_CurveFunction)(const void*, float) = nullptr;
+
+		double m_StartOffsetInSeconds = 0.0;
+		double m_TimeScale = 1.0;
+		double m_CycleDurationInSeconds = 0.0;
+		double m_InverseCycleDuration = 0.0;
+		double m_TotalDurationInSeconds = 0.0;
+		std::size_t m_RepeatCount = 0;
+		std::size_t m_ReverseCount = 0;
+		bool m_Forward = true;
+
+		EaseFunction m_Ease = &ease::Linear;
+		std::shared_ptr<const CurveAsset> m_Curve;
+		std::shared_ptr<const void> m_CurveObject;
+
+		std::size_t m_LoopCount = 0;
+		bool m_Done = false;
+
+	};
+
+	template <typename TAnimation>
+	AnimationBuilder<AnimationPlan> Compile(const AnimationBuilder<TAnimation>& builder)
+	{
+		return AnimationBuilder<AnimationPlan>(
+			AnimationPlan(builder.GetAnimation())
+		);
+	}
+
+	class AnimationClip
+	{
+	public:
+
+		AnimationClip(std::vector<std::uint16_t> samples, float durationInSeconds, float scale, float offset):
+			m_OwnedSamples(std::move(samples)),
+			m_Samples(m_OwnedSamples),
+			m_DurationInSeconds(durationInSeconds),
+			m_SamplesPerSecond(m_Samples.size() > 1 and durationInSeconds > 0.0f ? static_cast<double>(m_Samples.size() - 1) / durationInSeconds : 0.0),
+			m_Scale(scale),
+			m_Offset(offset)
+		{
+		}
+
+		// References samples owned elsewhere, e.g. in a mapped file; `owner` keeps them alive.
+		AnimationClip(std::span<const std::uint16_t> samples, float durationInSeconds, float scale, float offset, std::shared_ptr<const void> owner = nullptr):
+			m_Owner(std::move(owner)),
+			m_Samples(samples),
+			m_DurationInSeconds(durationInSeconds),
+			m_SamplesPerSecond(m_Samples.size() > 1 and durationInSeconds > 0.0f ? static_cast<double>(m_Samples.size() - 1) / durationInSeconds : 0.0),
+			m_Scale(scale),
+			m_Offset(offset)
+		{
+		}
+
+		AnimationClip(const AnimationClip&) = delete;
+		AnimationClip& operator = (const AnimationClip&) = delete;
+
+		float Sample(double timeInSeconds) const
+		{
+			if (m_Samples.size() < 2)
+			{
+				return m_Samples.empty() ? m_Offset : Decode(0);
+			}
+
+			std::size_t last = m_Samples.size() - 1;
+			double position = std::clamp(timeInSeconds * m_SamplesPerSecond, 0.0, static_cast<double>(last));
+			std::size_t index = std::min(static_cast<std::size_t>(position), last - 1);
+
+			return std::lerp(Decode(index), Decode(index + 1), static_cast<float>(position - static_cast<double>(index)));
+		}
+
+		std::span<const std::uint16_t> GetSamples() const { return m_Samples; }
+		float GetDurationInSeconds() const { return m_DurationInSeconds; }
+		float GetScale() const { return m_Scale; }
+		float GetOffset() const { return m_Offset; }
+
+	private:
+
+		float Decode(std::size_t index) const
+		{
+			return m_Offset + m_Scale * static_cast<float>(m_Samples[index]);
+		}
+
+		std::vector<std::uint16_t> m_OwnedSamples;
+		std::shared_ptr<const void> m_Owner;
+		std::span<const std::uint16_t> m_Samples;
+		float m_DurationInSeconds;
+		double m_SamplesPerSecond;
+		float m_Scale;
+		float m_Offset;
+
+	};
+
+	class ClipAnimation
+	{
+	public:
+
+		explicit ClipAnimation(std::shared_ptr<const AnimationClip> clip):
+			m_Clip(std::move(clip))
+		{
+		}
+
+		bool IsDone() const
+		{
+			return m_ElapsedTimeInSeconds >= m_Clip->GetDurationInSeconds();
+		}
+
+		void OnDone() const
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return 0;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return m_Clip->GetDurationInSeconds() / m_TimeScale;
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			double durationInSeconds = m_Clip->GetDurationInSeconds();
+			double elapsedTimeInSeconds = m_ElapsedTimeInSeconds + static_cast<double>(deltaTime) * m_TimeScale;
+			m_ElapsedTimeInSeconds = std::min(elapsedTimeInSeconds, durationInSeconds);
+
+			if (m_ElapsedTimeInSeconds >= 0.0)
+			{
+				m_Progress = m_Clip->Sample(m_Forward ? m_ElapsedTimeInSeconds : durationInSeconds - m_ElapsedTimeInSeconds);
+			}
+
+			return m_TimeScale > 0.0f ? static_cast<float>(std::max(elapsedTimeInSeconds - durationInSeconds, 0.0) / m_TimeScale) : 0.0f;
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			return initialValue + (targetValue - initialValue) * m_Progress;
+		}
+
+		void Repeat()
+		{
+			m_ElapsedTimeInSeconds = 0.0f;
+		}
+
+		void Reverse()
+		{
+			m_Forward = not m_Forward;
+		}
+
+		void ApplySpeed(float speedFactor)
+		{
+			m_TimeScale *= std::max(speedFactor, 0.0f);
+		}
+
+		void ApplyDelay(float delayInSeconds)
+		{
+			m_ElapsedTimeInSeconds -= delayInSeconds * m_TimeScale;
+		}
+
+		const std::shared_ptr<const AnimationClip>& GetClip() const
+		{
+			return m_Clip;
+		}
+
+	private:
+
+		std::shared_ptr<const AnimationClip> m_Clip;
+		double m_ElapsedTimeInSeconds = 0.0;
+		float m_TimeScale = 1.0f;
+		float m_Progress = 0.0f;
+		bool m_Forward = true;
+
+	};
+
+	struct ProgressSamples
+	{
+		std::vector<float> Values;
+		float DurationInSeconds;
+	};
+
+	template <typename TAnimation>
+	ProgressSamples SampleProgress(const AnimationBuilder<TAnimation>& builder, float samplesPerSecond = 60.0f, float maxDurationInSeconds = 60.0f)
+	{
+		auto step = [](TAnimation& animation, float& progress, float deltaTime)
+		{
+			float remainingTime = UpdateAnimation(animation, 0.0f, 1.0f, progress, deltaTime);
+			progress = animation.GetValue(0.0f, 1.0f, progress);
+
+			if (animation.IsDone())
+			{
+				animation.OnDone();
+			}
+
+			return animation.IsDone() ? remainingTime : -1.0f;
+		};
+
+		// Finds where the chain ends, so the samples can span it exactly.
+		float durationInSeconds = maxDurationInSeconds;
+		{
+			TAnimation animation = builder.GetAnimation();
+			float progress = 0.0f;
+			float deltaTime = 1.0f / samplesPerSecond;
+
+			for (float time = 0.0f; time < maxDurationInSeconds; time += deltaTime)
+			{
+				float remainingTime = step(animation, progress, deltaTime);
+				if (remainingTime >= 0.0f)
+				{
+					durationInSeconds = std::clamp(time + deltaTime - remainingTime, 0.0f, maxDurationInSeconds);
+					break;
+				}
+			}
+		}
+
+		std::size_t count = static_cast<std::size_t>(std::ceil(durationInSeconds * samplesPerSecond)) + 1;
+		float deltaTime = count > 1 ? durationInSeconds / static_cast<float>(count - 1) : 0.0f;
+
+		ProgressSamples samples{ {}, durationInSeconds };
+		samples.Values.reserve(count);
+
+		TAnimation animation = builder.GetAnimation();
+		float progress = 0.0f;
+
+		step(animation, progress, 0.0f);
+		samples.Values.push_back(progress);
+
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			step(animation, progress, deltaTime);
+			samples.Values.push_back(progress);
+		}
+
+		return samples;
+	}
+
+	template <typename TAnimation>
+	AnimationBuilder<ClipAnimation> Bake(const AnimationBuilder<TAnimation>& builder, float samplesPerSecond = 60.0f, float maxDurationInSeconds = 60.0f)
+	{
+		ProgressSamples progress = SampleProgress(builder, samplesPerSecond, maxDurationInSeconds);
+		const std::vector<float>& values = progress.Values;
+
+		auto [minimum, maximum] = std::minmax_element(values.begin(), values.end());
+		float offset = *minimum;
+		float scale = (*maximum - *minimum) / static_cast<float>(std::numeric_limits<std::uint16_t>::max());
+
+		std::vector<std::uint16_t> samples(values.size());
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			samples[i] = scale > 0.0f ? static_cast<std::uint16_t>(std::lround((values[i] - offset) / scale)) : 0;
+		}
+
+		return AnimationBuilder<ClipAnimation>(
+			ClipAnimation(std::make_shared<const AnimationClip>(std::move(samples), progress.DurationInSeconds, scale, offset))
+		);
+	}
+
+	class CurveCompressor
+	{
+	public:
+
+		CurveCompressor(std::span<const float> samples, float tolerance):
+			m_Samples(samples),
+			m_Tolerance(tolerance)
+		{
+		}
+
+		// Places keys on samples greedily: each segment is extended one sample at a time for as long
+		// as some ease function keeps it within the tolerance. This gives few segments, not
+		// necessarily the fewest. Returns each segment's ease function; GetKeys holds the sample
+		// index of every key.
+		std::vector<EaseFunction> Compress()
+		{
+			std::vector<EaseFunction> functions;
+			m_Keys.assign(1, 0);
+
+			std::size_t last = m_Samples.size() - 1;
+			while (m_Keys.back() < last)
+			{
+				std::size_t from = m_Keys.back();
+
+				// Two neighbouring samples always fit a straight line.
+				std::size_t to = from + 1;
+				EaseFunction ease = &ease::Linear;
+
+				for (std::size_t next = to + 1; next <= last; ++next)
+				{
+					EaseFunction fit = FitSegment(from, next);
+					if (fit == nullptr)
+					{
+						break;
+					}
+
+					to = next;
+					ease = fit;
+				}
+
+				m_Keys.push_back(to);
+				functions.push_back(ease);
+			}
+
+			return functions;
+		}
+
+		std::span<const std::size_t> GetKeys() const
+		{
+			return m_Keys;
+		}
+
+	private:
+
+		EaseFunction FitSegment(std::size_t from, std::size_t to) const
+		{
+			float start = m_Samples[from];
+			float end = m_Samples[to];
+			float inverseLength = 1.0f / static_cast<float>(to - from);
+
+			EaseFunction best = nullptr;
+			float bestError = m_Tolerance;
+
+			for (const ease::NamedFunction& function : ease::Functions)
+			{
+				float error = 0.0f;
+				for (std::size_t i = from + 1; i < to and error <= bestError; ++i)
+				{
+					float x = static_cast<float>(i - from) * inverseLength;
+					error = std::max(error, std::abs(std::lerp(start, end, function.Function(x)) - m_Samples[i]));
+				}
+
+				if (error <= bestError)
+				{
+					best = function.Function;
+					bestError = error;
+				}
+			}
+
+			return best;
+		}
+
+		std::span<const float> m_Samples;
+		float m_Tolerance;
+		std::vector<std::size_t> m_Keys;
+
+	};
+
+	inline AnimationBuilder<TimingCurveAnimation> CompressCurve(std::span<const float> samples, float durationInSeconds, float tolerance)
+	{
+		float secondsPerSample = samples.size() > 1 ? durationInSeconds / static_cast<float>(samples.size() - 1) : 0.0f;
+
+		if (samples.size() < 2)
+		{
+			return TimingCurve(durationInSeconds, std::vector<float>(samples.begin(), samples.end()), std::vector<EaseFunction>{});
+		}
+
+		if (samples.size() == 2)
+		{
+			// Nothing to compress, but the key is still timed so the curve lasts `durationInSeconds`.
+			return *TimingCurve(std::vector<float>(samples.begin(), samples.end()), std::vector<EaseFunction>{}, std::vector<float>{ secondsPerSample });
+		}
+
+		CurveCompressor compressor(samples, tolerance);
+		std::vector<EaseFunction> functions = compressor.Compress();
+		std::span<const std::size_t> keys = compressor.GetKeys();
+
+		// Keys land wherever a segment stopped fitting, so each segment keeps its own duration.
+
+		std::vector<float> values;
+		std::vector<float> durations;
+		for (std::size_t key = 0; key < keys.size(); ++key)
+		{
+			values.push_back(samples[keys[key]]);
+			if (key > 0)
+			{
+				durations.push_back(static_cast<float>(keys[key] - keys[key - 1]) * secondsPerSample);
+			}
+		}
+
+		return *TimingCurve(std::move(values), std::move(functions), std::move(durations));
+	}
+
+	template <typename TAnimation>
+	AnimationBuilder<TimingCurveAnimation> CompressCurve(const AnimationBuilder<TAnimation>& builder, float tolerance, float samplesPerSecond = 60.0f, float maxDurationInSeconds = 60.0f)
+	{
+		ProgressSamples progress = SampleProgress(builder, samplesPerSecond, maxDurationInSeconds);
+		return CompressCurve(progress.Values, progress.DurationInSeconds, tolerance);
+	}
+
+	class BytecodeAnimation
+	{
+	public:
+
+		enum class Opcode : std::uint32_t
+		{
+			Speed,
+			Repeat,
+			Ease,
+			Keys,
+			Instant,
+			Never
+		};
+
+		inline static constexpr std::uint32_t Infinite = std::numeric_limits<std::uint32_t>::max();
+
+		// Keeps the program alive, so reloading the library that produced it is safe.
+		explicit BytecodeAnimation(std::shared_ptr<const std::uint32_t> program):
+			m_Program(std::move(program))
+		{
+		}
+
+		// The caller keeps `program` alive for as long as the animation runs.
+		explicit BytecodeAnimation(const std::uint32_t* program):
+			m_Program(std::shared_ptr<const void>(), program)
+		{
+		}
+
+		bool IsDone() const
+		{
+			return GetElapsedTimeInSeconds() >= GetEndTime();
+		}
+
+		void OnDone() const
+		{
+		}
+
+		std::size_t GetLoopCount() const
+		{
+			return m_LoopCount;
+		}
+
+		float GetCycleDurationInSeconds() const
+		{
+			return (GetEndTime() - GetStartOffset()) / m_TimeScale;
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime)
+		{
+			return Update(initialValue, targetValue, currentValue, ToTicks(deltaTime));
+		}
+
+		template <typename T>
+		float Update(const T& initialValue, const T& targetValue, const T& currentValue, Ticks deltaTime)
+		{
+			m_ElapsedTime += m_TimeScale == 1.0f ? deltaTime : Ticks(std::llround(static_cast<double>(deltaTime.count()) * m_TimeScale));
+
+			double elapsedTimeInSeconds = GetElapsedTimeInSeconds();
+			double startOffset = GetStartOffset();
+			double endTime = GetEndTime();
+
+			m_Progress = elapsedTimeInSeconds < startOffset
+				? 0.0f
+				: Execute(std::min(elapsedTimeInSeconds, endTime) - startOffset, m_LoopCount);
+
+			return m_TimeScale > 0.0f ? static_cast<float>(std::max(elapsedTimeInSeconds - endTime, 0.0) / m_TimeScale) : 0.0f;
+		}
+
+		template <typename T>
+		T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const
+		{
+			return initialValue + (targetValue - initialValue) * m_Progress;
+		}
+
+		void Repeat()
+		{
+			m_ElapsedTime = ToTicks(GetStartOffset());
+		}
+
+		void Reverse()
+		{
+			m_Forward = not m_Forward;
+		}
+
+		// Programs are shared, so speed and delay applied later scale and shift this animation's own clock.
+		void ApplySpeed(float speedFactor)
+		{
+			m_TimeScale *= std::max(speedFactor, 0.0f);
+		}
+
+		void ApplyDelay(float delayInSeconds)
+		{
+			m_ElapsedTime -= ToTicks(delayInSeconds * m_TimeScale);
+		}
+
+	private:
+
+		static float ToFloat(std::uint32_t word)
+		{
+			return std::bit_cast<float>(word);
+		}
+
+		float GetStartOffset() const
+		{
+			return ToFloat(m_Program.get()[0]);
+		}
+
+		float GetEndTime() const
+		{
+			return ToFloat(m_Program.get()[1]);
+		}
+
+		double GetElapsedTimeInSeconds() const
+		{
+			return ToSeconds(m_ElapsedTime);
+		}
+
+		float Execute(double time, std::uint32_t& loopCount) const
+		{
+			bool forward = m_Forward;
+
+			for (const std::uint32_t* pc = m_Program.get() + 2;;)
+			{
+				switch (static_cast<Opcode>(*pc & 0xFF))
+				{
+					case Opcode::Speed:
+					{
+						time *= ToFloat(pc[1]);
+						pc += 2;
+						break;
+					}
+					case Opcode::Repeat:
+					{
+						double cycleDuration = ToFloat(pc[3]);
+						double count = pc[1] == Infinite ? std::numeric_limits<double>::infinity() : static_cast<double>(pc[1]);
+						double cycle = std::min(std::floor(time / cycleDuration), count);
+
+						time -= cycle * cycleDuration;
+						loopCount = cycle < static_cast<double>(Infinite) ? static_cast<std::uint32_t>(cycle) : Infinite;
+						std::uint32_t reverses = cycle >= static_cast<double>(pc[2]) ? pc[2] : static_cast<std::uint32_t>(cycle);
+						forward = forward == (reverses % 2 == 0);
+						pc += 4;
+						break;
+					}
+					case Opcode::Ease:
+					{
+						float duration = ToFloat(pc[1]);
+						float progress = duration > 0.0f ? std::clamp(static_cast<float>(time) / duration, 0.0f, 1.0f) : 1.0f;
+						return ease::Functions[*pc >> 8].Function(forward ? progress : 1.0f - progress);
+					}
+					case Opcode::Keys:
+					{
+						std::uint32_t valueCount = *pc >> 8;
+						std::uint32_t functionCount = pc[1];
+						float durationPerValue = ToFloat(pc[2]);
+						const std::uint32_t* values = pc + 3;
+						const std::uint32_t* functions = values + valueCount;
+
+						if (valueCount < 2)
+						{
+							return valueCount == 0 ? 0.0f : ToFloat(values[0]);
+						}
+
+						std::uint32_t segments = valueCount - 1;
+						float position = durationPerValue > 0.0f ? static_cast<float>(time) / durationPerValue : static_cast<float>(segments);
+						std::uint32_t segment = std::min(static_cast<std::uint32_t>(position), segments - 1);
+
+						std::uint32_t from = forward ? segment : segments - segment;
+						std::uint32_t to = forward ? from + 1 : from - 1;
+
+						EaseFunction ease = &ease::Linear;
+						if (functionCount > 0)
+						{
+							std::uint32_t function = std::min(segment, functionCount - 1);
+							ease = ease::Functions[functions[forward ? function : functionCount - 1 - function]].Function;
+						}
+
+						float x = std::min(position - static_cast<float>(segment), 1.0f);
+						return std::lerp(ToFloat(values[from]), ToFloat(values[to]), ease(x));
+					}
+					case Opcode::Instant:
+						return 1.0f;
+					default:
+						return 0.0f;
+				}
+			}
+		}
+
+		std::shared_ptr<const std::uint32_t> m_Program;
+		Ticks m_ElapsedTime{};
+		float m_TimeScale = 1.0f;
+		float m_Progress = 0.0f;
+		std::uint32_t m_LoopCount = 0;
+		bool m_Forward = true;
+
+	};
+
+	class AnimationLibrary
+	{
+	public:
+
+		// Each load writes a new code block; animations found earlier keep the old one alive.
+		// A source that fails to parse leaves the previously loaded animations in place.
+		bool Load(std::string_view source)
+		{
+			auto code = std::make_shared<std::vector<std::uint32_t>>();
+			std::map<std::string, std::size_t, std::less<>> entries;
+
+			for (std::size_t line = 1; not source.empty(); ++line)
+			{
+				std::size_t end = source.find('\n');
+				Cursor cursor{ source.substr(0, end) };
+				source = end == std::string_view::npos ? std::string_view() : source.substr(end + 1);
+
+				cursor.Skip();
+				if (cursor.IsAtEnd())
+				{
+					continue;
+				}
+
+				std::string_view name = cursor.ParseIdentifier();
+				Definition definition;
+
+				if (name.empty() or not cursor.Accept('=') or not ParseExpression(cursor, definition) or not cursor.IsAtEnd())
+				{
+					m_Error = "line " + std::to_string(line) + ": " + (cursor.Error.empty() ? "syntax error" : cursor.Error);
+					return false;
+				}
+
+				entries.insert_or_assign(std::string(name), code->size());
+				Emit(*code, definition);
+			}
+
+			m_Code = std::move(code);
+			m_Entries = std::move(entries);
+			m_Error.clear();
+
+			return true;
+		}
+
+		std::optional<AnimationBuilder<BytecodeAnimation>> Find(std::string_view name) const
+		{
+			auto entry = m_Entries.find(name);
+			if (entry == m_Entries.end())
+			{
+				return std::nullopt;
+			}
+
+			return AnimationBuilder<BytecodeAnimation>(
+				BytecodeAnimation(std::shared_ptr<const std::uint32_t>(m_Code, m_Code->data() + entry->second))
+			);
+		}
+
+		const std::string& GetError() const
+		{
+			return m_Error;
+		}
+
+		const std::vector<std::uint32_t>& GetCode() const
+		{
+			return *m_Code;
+		}
+
+	private:
+
+		typedef BytecodeAnimation::Opcode Opcode;
+
+		struct Cursor
+		{
+			std::string_view Source;
+			std::string Error = {};
+
+			void Skip()
+			{
+				std::size_t count = Source.find_first_not_of(" \t\r");
+				Source.remove_prefix(count == std::string_view::npos ? Source.size() : count);
+
+				if (not Source.empty() and Source.front() == '#')
+				{
+					Source = {};
+				}
+			}
+
+			bool IsAtEnd()
+			{
+				Skip();
+				return Source.empty();
+			}
+
+			bool Accept(char c)
+			{
+				Skip();
+				if (Source.empty() or Source.front() != c)
+				{
+					return false;
+				}
+
+				Source.remove_prefix(1);
+				return true;
+			}
+
+			bool Expect(char c)
+			{
+				if (Accept(c))
+				{
+					return true;
+				}
+
+				Error = std::string("expected '") + c + "'";
+				return false;
+			}
+
+			std::string_view ParseIdentifier()
+			{
+				Skip();
+				std::size_t count = 0;
+				while (count < Source.size() and (std::isalnum(static_cast<unsigned char>(Source[count])) or Source[count] == '_'))
+				{
+					++count;
+				}
+
+				std::string_view identifier = Source.substr(0, count);
+				Source.remove_prefix(count);
+				return identifier;
+			}
+
+			bool ParseNumber(float& value)
+			{
+				Skip();
+				auto [end, error] = std::from_chars(Source.data(), Source.data() + Source.size(), value);
+				if (error != std::errc())
+				{
+					Error = "expected a number";
+					return false;
+				}
+
+				Source.remove_prefix(end - Source.data());
+				return true;
+			}
+
+			bool ParseCount(std::size_t& value)
+			{
+				Skip();
+				auto [end, error] = std::from_chars(Source.data(), Source.data() + Source.size(), value);
+				if (error != std::errc())
+				{
+					Error = "expected a count";
+					return false;
+				}
+
+				Source.remove_prefix(end - Source.data());
+				return true;
+			}
+
+			bool ParseFunction(std::uint32_t& index)
+			{
+				std::string_view name = ParseIdentifier();
+				index = static_cast<std::uint32_t>(ease::FindIndex(name));
+				if (index < ease::Functions.size())
+				{
+					return true;
+				}
+
+				Error = "unknown ease function '" + std::string(name) + "'";
+				return false;
+			}
+		};
+
+		enum class Source
+		{
+			Ease,
+			Keys,
+			Instant,
+			Never
+		};
+
+		struct Definition
+		{
+			Source Kind = Source::Never;
+			std::uint32_t Function = 0;
+			float DurationInSeconds = 0.0f;
+			std::vector<float> Values;
+			std::vector<std::uint32_t> Functions;
+
+			float StartOffsetInSeconds = 0.0f;
+			float TimeScale = 1.0f;
+			bool HasRepeat = false;
+			std::uint32_t RepeatCount = 0;
+			std::uint32_t ReverseCount = 0;
+		};
+
+		static std::uint32_t ToCount(std::size_t count)
+		{
+			return static_cast<std::uint32_t>(std::min<std::size_t>(count, BytecodeAnimation::Infinite - 1));
+		}
+
+		static bool ParseExpression(Cursor& cursor, Definition& definition)
+		{
+			if (not ParseSource(cursor, definition))
+			{
+				return false;
+			}
+
+			while (cursor.Accept('.'))
+			{
+				if (not ParseModifier(cursor, definition))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		static bool ParseSource(Cursor& cursor, Definition& definition)
+		{
+			std::string_view name = cursor.ParseIdentifier();
+			if (not cursor.Expect('('))
+			{
+				return false;
+			}
+
+			if (name == "Instant" or name == "Never")
+			{
+				definition.Kind = name == "Instant" ? Source::Instant : Source::Never;
+				return cursor.Expect(')');
+			}
+
+			if (name == "TimingCurve")
+			{
+				definition.Kind = Source::Keys;
+				if (not cursor.ParseNumber(definition.DurationInSeconds) or not cursor.Expect(',') or not cursor.Expect('['))
+				{
+					return false;
+				}
+
+				do
+				{
+					float value = 0.0f;
+					if (not cursor.ParseNumber(value))
+					{
+						return false;
+					}
+
+					definition.Values.push_back(value);
+				} while (cursor.Accept(','));
+
+				if (not cursor.Expect(']') or not cursor.Expect(',') or not cursor.Expect('['))
+				{
+					return false;
+				}
+
+				do
+				{
+					std::uint32_t function = 0;
+					if (not cursor.ParseFunction(function))
+					{
+						return false;
+					}
+
+					definition.Functions.push_back(function);
+				} while (cursor.Accept(','));
+
+				return cursor.Expect(']') and cursor.Expect(')');
+			}
+
+			if (not name.starts_with("Ease"))
+			{
+				cursor.Error = "unknown animation '" + std::string(name) + "'";
+				return false;
+			}
+
+			Cursor function{ name.substr(4) };
+			definition.Kind = Source::Ease;
+			definition.DurationInSeconds = TimedAnimation::DefaultDuration;
+
+			if (not function.ParseFunction(definition.Function))
+			{
+				cursor.Error = "unknown animation '" + std::string(name) + "'";
+				return false;
+			}
+
+			if (not cursor.Accept(')'))
+			{
+				return cursor.ParseNumber(definition.DurationInSeconds) and cursor.Expect(')');
+			}
+
+			return true;
+		}
+
+		static bool ParseModifier(Cursor& cursor, Definition& definition)
+		{
+			std::string_view name = cursor.ParseIdentifier();
+			if (not cursor.Expect('('))
+			{
+				return false;
+			}
+
+			if (name == "Delay" or name == "Speed")
+			{
+				float value = 0.0f;
+				if (not cursor.ParseNumber(value) or not cursor.Expect(')'))
+				{
+					return false;
+				}
+
+				if (name == "Delay")
+				{
+					definition.StartOffsetInSeconds += value;
+				}
+				else if (value > 0.0f)
+				{
+					definition.StartOffsetInSeconds /= value;
+					definition.TimeScale *= value;
+				}
+				else
+				{
+					definition.TimeScale = 0.0f;
+				}
+
+				return true;
+			}
+
+			if (name != "Repeat" and name != "RepeatFor" and name != "ReverseFor")
+			{
+				cursor.Error = "unknown modifier '" + std::string(name) + "'";
+				return false;
+			}
+
+			if (definition.HasRepeat)
+			{
+				cursor.Error = "only one repeat per animation is supported";
+				return false;
+			}
+
+			std::size_t count = 0;
+			if (name != "Repeat" and not cursor.ParseCount(count))
+			{
+				return false;
+			}
+
+			definition.HasRepeat = true;
+			definition.RepeatCount = name == "RepeatFor" ? ToCount(count > 0 ? count - 1 : 0) : BytecodeAnimation::Infinite;
+			definition.ReverseCount = name == "ReverseFor" ? ToCount(count) : 0;
+
+			return cursor.Expect(')');
+		}
+
+		void Emit(std::vector<std::uint32_t>& code, const Definition& definition)
+		{
+			float cycleDuration = 0.0f;
+			switch (definition.Kind)
+			{
+				case Source::Ease:
+					cycleDuration = std::max(definition.DurationInSeconds, 0.0f);
+					break;
+				case Source::Keys:
+					cycleDuration = definition.Values.size() < 2
+						? 0.0f
+						: definition.DurationInSeconds / static_cast<float>(definition.Values.size()) * static_cast<float>(definition.Values.size() - 1);
+					break;
+				case Source::Instant:
+					break;
+				case Source::Never:
+					cycleDuration = std::numeric_limits<float>::infinity();
+					break;
+			}
+
+			bool repeats = definition.HasRepeat and cycleDuration > 0.0f and not std::isinf(cycleDuration);
+
+			float totalDuration = cycleDuration;
+			if (repeats)
+			{
+				totalDuration = definition.RepeatCount == BytecodeAnimation::Infinite
+					? std::numeric_limits<float>::infinity()
+					: cycleDuration * static_cast<float>(definition.RepeatCount + 1);
+			}
+
+			float activeDuration = 0.0f;
+			if (totalDuration > 0.0f)
+			{
+				activeDuration = definition.TimeScale > 0.0f ? totalDuration / definition.TimeScale : std::numeric_limits<float>::infinity();
+			}
+
+			EmitFloat(code, definition.StartOffsetInSeconds);
+			EmitFloat(code, definition.StartOffsetInSeconds + activeDuration);
+
+			if (definition.TimeScale != 1.0f)
+			{
+				EmitOpcode(code, Opcode::Speed);
+				EmitFloat(code, definition.TimeScale);
+			}
+
+			if (repeats)
+			{
+				EmitOpcode(code, Opcode::Repeat);
+				code.push_back(definition.RepeatCount);
+				code.push_back(definition.ReverseCount);
+				EmitFloat(code, cycleDuration);
+			}
+
+			switch (definition.Kind)
+			{
+				case Source::Ease:
+					EmitOpcode(code, Opcode::Ease, definition.Function);
+					EmitFloat(code, definition.DurationInSeconds);
+					break;
+				case Source::Keys:
+					EmitOpcode(code, Opcode::Keys, static_cast<std::uint32_t>(definition.Values.size()));
+					code.push_back(static_cast<std::uint32_t>(definition.Functions.size()));
+					EmitFloat(code, definition.DurationInSeconds / static_cast<float>(std::max<std::size_t>(definition.Values.size(), 1)));
+					for (float value : definition.Values)
+					{
+						EmitFloat(code, value);
+					}
+					code.insert(code.end(), definition.Functions.begin(), definition.Functions.end());
+					break;
+				case Source::Instant:
+					EmitOpcode(code, Opcode::Instant);
+					break;
+				case Source::Never:
+					EmitOpcode(code, Opcode::Never);
+					break;
+			}
+		}
+
+		void EmitOpcode(std::vector<std::uint32_t>& code, Opcode opcode, std::uint32_t operand = 0)
+		{
+			code.push_back(static_cast<std::uint32_t>(opcode) | (operand << 8));
+		}
+
+		void EmitFloat(std::vector<std::uint32_t>& code, float value)
+		{
+			code.push_back(std::bit_cast<std::uint32_t>(value));
+		}
+
+		std::shared_ptr<std::vector<std::uint32_t>> m_Code = std::make_shared<std::vector<std::uint32_t>>();
+		std::map<std::string, std::size_t, std::less<>> m_Entries;
+		std::string m_Error;
+
+	};
+	
+	
+	class MappedAnimationLibrary
+	{
+	public:
+
+		// Layout: Header | Entry[EntryCount] sorted by name | names | payloads. Every section and payload starts on an Alignment boundary.
+		inline static constexpr std::array<char, 4> Magic = { 'U', 'I', 'A', 'L' };
+		inline static constexpr std::uint32_t Version = 1;
+		inline static constexpr std::uint32_t ByteOrderMark = 0x01020304;
+		inline static constexpr std::size_t Alignment = 16;
+
+		enum class EntryKind : std::uint32_t
+		{
+			Curve,
+			Clip
+		};
+
+		struct Header
+		{
+			std::array<char, 4> Magic;
+			std::uint32_t Version;
+			std::uint32_t ByteOrderMark;
+			std::uint32_t Size;
+			std::uint32_t EntryCount;
+			std::uint32_t EntryOffset;
+			std::uint32_t NameOffset;
+			std::uint32_t PayloadOffset;
+		};
+
+		struct Entry
+		{
+			std::uint32_t NameOffset;
+			std::uint32_t NameLength;
+			EntryKind Kind;
+			std::uint32_t ValueOffset;
+			std::uint32_t ValueCount;
+			std::uint32_t FunctionOffset;
+			std::uint32_t FunctionCount;
+			float DurationInSeconds;
+			float Scale;
+			float Offset;
+			std::uint32_t Reserved[2];
+		};
+
+		static_assert(sizeof(Header) == 32 and sizeof(Entry) == 48);
+
+		class Writer
+		{
+		public:
+
+			// Fails when a function is not one of ease::Functions, since only their indices are stored.
+			bool AddCurve(std::string name, float durationInSeconds, std::span<const float> values, std::span<const EaseFunction> functions)
+			{
+				std::vector<std::uint8_t> indices;
+				for (EaseFunction function : functions)
+				{
+					auto found = std::ranges::find(ease::Functions, function, &ease::NamedFunction::Function);
+					if (found == ease::Functions.end())
+					{
+						return false;
+					}
+
+					indices.push_back(static_cast<std::uint8_t>(found - ease::Functions.begin()));
+				}
+
+				std::vector<std::byte> payload(values.size_bytes());
+				std::memcpy(payload.data(), values.data(), values.size_bytes());
+
+				m_Entries[std::move(name)] = { EntryKind::Curve, std::move(payload), std::move(indices), static_cast<std::uint32_t>(values.size()), durationInSeconds, 0.0f, 0.0f };
+				return true;
+			}
+
+			void AddClip(std::string name, const AnimationClip& clip)
+			{
+				std::span<const std::uint16_t> samples = clip.GetSamples();
+
+				std::vector<std::byte> payload(samples.size_bytes());
+				std::memcpy(payload.data(), samples.data(), samples.size_bytes());
+
+				m_Entries[std::move(name)] = { EntryKind::Clip, std::move(payload), {}, static_cast<std::uint32_t>(samples.size()), clip.GetDurationInSeconds(), clip.GetScale(), clip.GetOffset() };
+			}
+
+			std::vector<std::byte> Finish() const
+			{
+				std::vector<std::byte> data(sizeof(Header));
+
+				Header header{ Magic, Version, ByteOrderMark, 0, static_cast<std::uint32_t>(m_Entries.size()), 0, 0, 0 };
+				header.EntryOffset = Align(data);
+				data.resize(data.size() + m_Entries.size() * sizeof(Entry));
+
+				std::vector<Entry> entries;
+				header.NameOffset = Align(data);
+				for (const auto& [name, pending] : m_Entries)
+				{
+					Entry entry{};
+					entry.NameOffset = Append(data, std::as_bytes(std::span(name)));
+					entry.NameLength = static_cast<std::uint32_t>(name.size());
+					entry.Kind = pending.Kind;
+					entry.ValueCount = pending.Count;
+					entry.FunctionCount = static_cast<std::uint32_t>(pending.Functions.size());
+					entry.DurationInSeconds = pending.DurationInSeconds;
+					entry.Scale = pending.Scale;
+					entry.Offset = pending.Offset;
+					entries.push_back(entry);
+				}
+
+				header.PayloadOffset = Align(data);
+				std::size_t index = 0;
+				for (const auto& [name, pending] : m_Entries)
+				{
+					Align(data);
+					entries[index].ValueOffset = Append(data, pending.Payload);
+					Align(data);
+					entries[index].FunctionOffset = Append(data, std::as_bytes(std::span(pending.Functions)));
+					++index;
+				}
+
+				header.Size = static_cast<std::uint32_t>(data.size());
+				std::memcpy(data.data(), &header, sizeof(Header));
+				std::memcpy(data.data() + header.EntryOffset, entries.data(), entries.size() * sizeof(Entry));
+				return data;
+			}
+
+		private:
+
+			struct Pending
+			{
+				EntryKind Kind;
+				std::vector<std::byte> Payload;
+				std::vector<std::uint8_t> Functions;
+				std::uint32_t Count;
+				float DurationInSeconds;
+				float Scale;
+				float Offset;
+			};
+
+			static std::uint32_t Align(std::vector<std::byte>& data)
+			{
+				data.resize((data.size() + Alignment - 1) / Alignment * Alignment);
+				return static_cast<std::uint32_t>(data.size());
+			}
+
+			static std::uint32_t Append(std::vector<std::byte>& data, std::span<const std::byte> bytes)
+			{
+				std::uint32_t offset = static_cast<std::uint32_t>(data.size());
+				data.insert(data.end(), bytes.begin(), bytes.end());
+				return offset;
+			}
+
+			std::map<std::string, Pending, std::less<>> m_Entries;
+
+		};
+
+		// Validates the image and uses it in place; nothing is copied. `owner` is shared with every animation handed out.
+		bool Map(std::span<const std::byte> data, std::shared_ptr<const void> owner = nullptr)
+		{
+			m_Data = {};
+			m_Entries = {};
+			m_Owner.reset();
+
+			if (reinterpret_cast<std::uintptr_t>(data.data()) % Alignment != 0 or data.size() < sizeof(Header))
+			{
+				return Fail("image is misaligned or truncated");
+			}
+
+			Header header;
+			std::memcpy(&header, data.data(), sizeof(Header));
+
+			if (header.Magic != Magic)
+				return Fail("not an animation library");
+			if (header.ByteOrderMark != ByteOrderMark)
+				return Fail("library was written with a different byte order");
+			if (header.Version != Version)
+				return Fail("unsupported library version " + std::to_string(header.Version));
+			if (header.Size != data.size() or header.EntryOffset % alignof(Entry) != 0 or not Contains(data, header.EntryOffset, std::size_t{ header.EntryCount } * sizeof(Entry)))
+				return Fail("entry table is out of bounds");
+
+			std::span<const Entry> entries(reinterpret_cast<const Entry*>(data.data() + header.EntryOffset), header.EntryCount);
+			for (const Entry& entry : entries)
+			{
+				std::size_t valueSize = entry.Kind == EntryKind::Curve ? sizeof(float) : sizeof(std::uint16_t);
+
+				if (entry.Kind != EntryKind::Curve and entry.Kind != EntryKind::Clip)
+					return Fail("unknown entry kind");
+				if (not Contains(data, entry.NameOffset, entry.NameLength))
+					return Fail("entry name is out of bounds");
+				if (entry.ValueOffset % valueSize != 0 or not Contains(data, entry.ValueOffset, std::size_t{ entry.ValueCount } * valueSize))
+					return Fail("entry values are out of bounds");
+				if (not Contains(data, entry.FunctionOffset, entry.FunctionCount))
+					return Fail("entry functions are out of bounds");
+
+				const std::uint8_t* functions = reinterpret_cast<const std::uint8_t*>(data.data() + entry.FunctionOffset);
+				if (std::any_of(functions, functions + entry.FunctionCount, [](std::uint8_t index) { return index >= ease::Functions.size(); }))
+					return Fail("entry references an unknown ease function");
+			}
+
+			// FindEntry binary-searches the names, so they must be strictly ascending.
+			for (std::size_t i = 1; i < entries.size(); ++i)
+			{
+				if (not (GetName(data, entries[i - 1]) < GetName(data, entries[i])))
+					return Fail("entries are not sorted by name");
+			}
+
+			m_Data = data;
+			m_Entries = entries;
+			m_Owner = std::move(owner);
+			m_Error.clear();
+			return true;
+		}
+
+		std::optional<AnimationBuilder<TimingCurveAnimation>> FindCurve(std::string_view name) const
+		{
+			const Entry* entry = FindEntry(name, EntryKind::Curve);
+			if (entry == nullptr)
+			{
+				return std::nullopt;
+			}
+
+			return AnimationBuilder<TimingCurveAnimation>(
+				TimingCurveAnimation(entry->DurationInSeconds, std::make_shared<const CurveAsset>(
+					std::span(reinterpret_cast<const float*>(m_Data.data() + entry->ValueOffset), entry->ValueCount),
+					std::span(reinterpret_cast<const std::uint8_t*>(m_Data.data() + entry->FunctionOffset), entry->FunctionCount),
+					m_Owner
+				))
+			);
+		}
+
+		std::optional<AnimationBuilder<ClipAnimation>> FindClip(std::string_view name) const
+		{
+			const Entry* entry = FindEntry(name, EntryKind::Clip);
+			if (entry == nullptr)
+			{
+				return std::nullopt;
+			}
+
+			return AnimationBuilder<ClipAnimation>(
+				ClipAnimation(std::make_shared<const AnimationClip>(
+					std::span(reinterpret_cast<const std::uint16_t*>(m_Data.data() + entry->ValueOffset), entry->ValueCount),
+					entry->DurationInSeconds,
+					entry->Scale,
+					entry->Offset,
+					m_Owner
+				))
+			);
+		}
+
+		std::size_t GetSize() const
+		{
+			return m_Entries.size();
+		}
+
+		const std::string& GetError() const
+		{
+			return m_Error;
+		}
+
+	private:
+
+		static bool Contains(std::span<const std::byte> data, std::size_t offset, std::size_t size)
+		{
+			return offset <= data.size() and size <= data.size() - offset;
+		}
+
+		bool Fail(std::string error)
+		{
+			m_Error = std::move(error);
+			return false;
+		}
+
+		static std::string_view GetName(std::span<const std::byte> data, const Entry& entry)
+		{
+			return std::string_view(reinterpret_cast<const char*>(data.data() + entry.NameOffset), entry.NameLength);
+		}
+
+		const Entry* FindEntry(std::string_view name, EntryKind kind) const
+		{
+			auto found = std::ranges::lower_bound(m_Entries, name, std::less<>{}, [this](const Entry& entry) { return GetName(m_Data, entry); });
+			if (found == m_Entries.end() or GetName(m_Data, *found) != name or found->Kind != kind)
+			{
+				return nullptr;
+			}
+
+			return &*found;
+		}
+
+		std::span<const std::byte> m_Data;
+		std::span<const Entry> m_Entries;
+		std::shared_ptr<const void> m_Owner;
+		std::string m_Error;
+
+	};
+
+	struct AnimationEvent
+	{
+		enum class Type : std::uint8_t
+		{
+			Looped,
+			Completed
+		};
+
+		Type Kind;
+		std::size_t LoopCount;
+		std::uint64_t Tag;
+	};
+
+	class AnimationEventQueue
+	{
+	public:
+
+		void Push(const AnimationEvent& event)
+		{
+			m_Events.push_back(event);
+		}
+
+		template <typename TCallback>
+		void Drain(TCallback&& callback)
+		{
+			for (const AnimationEvent& event : m_Events)
+			{
+				callback(event);
+			}
+
+			m_Events.clear();
+		}
+
+		const std::vector<AnimationEvent>& GetEvents() const
+		{
+			return m_Events;
+		}
+
+	private:
+
+		std::vector<AnimationEvent> m_Events;
+
+	};
+
+	// Runs any animation on T behind one interface, so owners can store chains of different types.
+	template <typename T>
+	class IAnimationWrapper
+	{
+	public:
+
+		virtual ~IAnimationWrapper() = default;
+
+		virtual bool IsDone() const = 0;
+		virtual void OnDone() = 0;
+		virtual std::size_t GetLoopCount() const = 0;
+		virtual void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime) = 0;
+		virtual void Update(const T& initialValue, const T& targetValue, const T& currentValue, Ticks deltaTime) = 0;
+		virtual T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const = 0;
+
+	};
+
+	template <typename T, typename TAnimation>
+	class AnimationWrapperImpl : public IAnimationWrapper<T>
+	{
+	public:
+
+		explicit AnimationWrapperImpl(TAnimation animation):
+			m_Animation(std::move(animation))
+		{
+		}
+
+		virtual bool IsDone() const override
+		{
+			return m_Animation.IsDone();
+		}
+
+		virtual void OnDone() override
+		{
+			m_Animation.OnDone();
+		}
+
+		virtual std::size_t GetLoopCount() const override
+		{
+			return GetAnimationLoopCount(m_Animation);
+		}
+
+		virtual void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime) override
+		{
+			m_Animation.Update(initialValue, targetValue, currentValue, deltaTime);
+		}
+
+		virtual void Update(const T& initialValue, const T& targetValue, const T& currentValue, Ticks deltaTime) override
+		{
+			if constexpr (requires { m_Animation.Update(initialValue, targetValue, currentValue, deltaTime); })
+			{
+				m_Animation.Update(initialValue, targetValue, currentValue, deltaTime);
+			}
+			else
+			{
+				m_Animation.Update(initialValue, targetValue, currentValue, static_cast<float>(ToSeconds(deltaTime)));
+			}
+		}
+
+		virtual T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const override
+		{
+			return m_Animation.GetValue(initialValue, targetValue, currentValue);
+		}
+
+	private:
+
+		TAnimation m_Animation;
+
+	};
+
+	// Holds one object implementing TInterface in TSize bytes of inline storage, so replacing it
+	// never allocates. Objects that do not fit are rejected at compile time.
+	template <typename TInterface, std::size_t TSize>
+	class InlineObject
+	{
+	public:
+
+		static_assert(std::has_virtual_destructor_v<TInterface>);
+
+		InlineObject() = default;
+		InlineObject(const InlineObject&) = delete;
+		InlineObject& operator = (const InlineObject&) = delete;
+
+		~InlineObject()
+		{
+			Reset();
+		}
+
+		template <typename TObject, typename... TArgs>
+		TObject& Emplace(TArgs&&... args)
+		{
+			static_assert(std::is_base_of_v<TInterface, TObject>);
+			static_assert(sizeof(TObject) <= TSize, "object does not fit into the inline storage, increase the slot size");
+			static_assert(alignof(TObject) <= alignof(std::max_align_t));
+
+			Reset();
+
+			TObject* object = new (m_Storage) TObject(std::forward<TArgs>(args)...);
+			m_Object = object;
+			return *object;
+		}
+
+		void Reset()
+		{
+			if (m_Object != nullptr)
+			{
+				m_Object->~TInterface();
+				m_Object = nullptr;
+			}
+		}
+
+		TInterface* Get() { return m_Object; }
+		const TInterface* Get() const { return m_Object; }
+
+		TInterface* operator -> () { return m_Object; }
+		const TInterface* operator -> () const { return m_Object; }
+
+		explicit operator bool () const { return m_Object != nullptr; }
+
+	private:
+
+		alignas(std::max_align_t) unsigned char m_Storage[TSize];
+		TInterface* m_Object = nullptr;
+
+	};
+
+	template <typename T>
+	class Animatable
+	{
+	public:
+
+		constexpr Animatable(const T& initialValue = T{}):
+			m_InitialValue(initialValue),
+			m_TargetValue(initialValue),
+			m_CurrentValue(initialValue),
+			m_Animation(nullptr)
+		{
+		}
+
+		template <typename TAnimation>
+		void WithAnimation(AnimationBuilder<TAnimation> builder, const T& targetValue)
+		{
+			m_InitialValue = m_CurrentValue;
+			m_TargetValue = targetValue;
+
+			m_Animation.reset(new AnimationWrapperImpl<T, TAnimation>(builder.GetAnimation()));
+		}
+
+		void WithoutAnimation(const T& targetValue)
+		{
+			m_InitialValue = targetValue;
+			m_TargetValue = targetValue;
+			m_CurrentValue = targetValue;
+			m_Animation.reset();
+		}
+
+		void Update(float deltaTime)
+		{
+			UpdateBy(deltaTime);
+		}
+
+		void Update(Ticks deltaTime)
+		{
+			UpdateBy(deltaTime);
+		}
+
+		void SetEventQueue(AnimationEventQueue* events, std::uint64_t tag = 0)
+		{
+			m_Events = events;
+			m_EventTag = tag;
+		}
+
+		operator const T& () const { return m_CurrentValue; }
+		const T* operator -> () const { return &m_CurrentValue; }
+
+		const T& GetInitialValue() const { return m_InitialValue; }
+		const T& GetTargetValue() const { return m_TargetValue; }
+		const T& GetCurrentValue() const { return m_CurrentValue; }
+		const T& Get() const { return m_CurrentValue; }
+
+		bool IsAnimating() const { return m_Animation != nullptr; }
+
+	private:
+
+		template <typename TTime>
+		void UpdateBy(TTime deltaTime)
+		{
+			if (m_Animation == nullptr)
+			{
+				return;
+			}
+
+			std::size_t loopCount = m_Events != nullptr ? m_Animation->GetLoopCount() : 0;
+
+			m_Animation->Update(m_InitialValue, m_TargetValue, m_CurrentValue, deltaTime);
+			m_CurrentValue = m_Animation->GetValue(m_InitialValue, m_TargetValue, m_CurrentValue);
+
+			bool done = m_Animation->IsDone();
+			if (done)
+			{
+				m_Animation->OnDone();
+				done = m_Animation->IsDone();
+			}
+
+			if (m_Events != nullptr)
+			{
+				std::size_t loops = m_Animation->GetLoopCount();
+				if (loops != loopCount)
+				{
+					m_Events->Push({ AnimationEvent::Type::Looped, loops, m_EventTag });
+				}
+
+				if (done)
+				{
+					m_Events->Push({ AnimationEvent::Type::Completed, loops, m_EventTag });
+				}
+			}
+
+			if (done)
+			{
+				m_Animation.reset();
+			}
+		}
+
+		T m_InitialValue;
+		T m_TargetValue;
+		T m_CurrentValue;
+
+		std::unique_ptr<IAnimationWrapper<T>> m_Animation;
+
+		AnimationEventQueue* m_Events = nullptr;
+		std::uint64_t m_EventTag = 0;
+
+	};
+
+	// Each change publishes a new immutable state, so readers on any thread see either the old
+	// animation or the new one, never a mix. The lock only guards swapping the state pointer.
+	template <typename T, typename TClock = std::chrono::steady_clock>
+	class ClockedAnimatable
+	{
+	public:
+
+		typedef typename TClock::time_point TimePoint;
+
+		ClockedAnimatable(const T& initialValue = T{}):
+			m_State(std::make_shared<const State>(State{ initialValue, initialValue, std::nullopt, TimePoint{} }))
+		{
+		}
+
+		template <typename TAnimation>
+		void WithAnimation(const AnimationBuilder<TAnimation>& builder, const T& targetValue)
+		{
+			TimePoint now = TClock::now();
+			Store(std::make_shared<const State>(State{ GetAt(now), targetValue, AnimationPlan(builder.GetAnimation()), now }));
+		}
+
+		void WithoutAnimation(const T& targetValue)
+		{
+			Store(std::make_shared<const State>(State{ targetValue, targetValue, std::nullopt, TimePoint{} }));
+		}
+
+		T GetAt(TimePoint time) const
+		{
+			std::shared_ptr<const State> state = Load();
+			if (not state->Plan.has_value())
+			{
+				return state->TargetValue;
+			}
+
+			float progress = state->Plan->GetProgressAt(state->GetElapsedTimeInSeconds(time));
+			return state->InitialValue + (state->TargetValue - state->InitialValue) * progress;
+		}
+
+		bool IsAnimatingAt(TimePoint time) const
+		{
+			std::shared_ptr<const State> state = Load();
+			return state->Plan.has_value() and not state->Plan->IsDoneAt(state->GetElapsedTimeInSeconds(time));
+		}
+
+		T Get() const { return GetAt(TClock::now()); }
+		operator T () const { return Get(); }
+
+		T GetInitialValue() const { return Load()->InitialValue; }
+		T GetTargetValue() const { return Load()->TargetValue; }
+
+		bool IsAnimating() const { return IsAnimatingAt(TClock::now()); }
+
+	private:
+
+		struct State
+		{
+			T InitialValue;
+			T TargetValue;
+			std::optional<AnimationPlan> Plan;
+			TimePoint StartTime;
+
+			double GetElapsedTimeInSeconds(TimePoint time) const
+			{
+				return std::chrono::duration<double>(time - StartTime).count();
+			}
+		};
+
+		std::shared_ptr<const State> Load() const
+		{
+			std::lock_guard lock(m_Mutex);
+			return m_State;
+		}
+
+		void Store(std::shared_ptr<const State> state)
+		{
+			std::lock_guard lock(m_Mutex);
+			m_State.swap(state);
+		}
+
+		mutable std::mutex m_Mutex;
+		std::shared_ptr<const State> m_State;
+
+	};
+
+	// Runs up to TCapacity animations on one value and blends them by weight; additive layers
+	// then add their offsets on top. Layers live in inline slots of TSlotSize bytes, so adding
+	// one never allocates. Additive layers take at most TCapacity - 1 slots, so WithAnimation
+	// always finds a blended layer to replace and never cuts an effect short.
+	template <typename T, std::size_t TCapacity = 4, std::size_t TSlotSize = 128>
+	class BlendedAnimatable
+	{
+	private:
+
+		struct Layer
+		{
+			// Empty while the slot is free.
+			InlineObject<IAnimationWrapper<T>, TSlotSize> Animation;
+
+			// Bumped each time the slot is reused, so handles to earlier layers stop matching.
+			std::uint32_t Generation = 0;
+
+			// Cleared once the animation is done; the layer then holds its last value until it fades out.
+			bool Running = false;
+
+			// Additive layers animate an offset from T{} and are dropped once done.
+			bool Additive = false;
+
+			T InitialValue;
+			T TargetValue;
+			T Value;
+
+			float Weight = 0.0f;
+			float TargetWeight = 0.0f;
+			float WeightPerSecond = 0.0f;
+		};
+
+	public:
+
+		// Refers to one layer until it is removed or done. An empty handle means no layer was added.
+		struct LayerHandle
+		{
+			std::uint32_t Index = 0;
+			std::uint32_t Generation = 0;
+
+			explicit operator bool () const { return Generation != 0; }
+		};
+
+		constexpr BlendedAnimatable(const T& initialValue = T{}):
+			m_TargetValue(initialValue),
+			m_BaseValue(initialValue),
+			m_CurrentValue(initialValue)
+		{
+		}
+
+		BlendedAnimatable(const BlendedAnimatable&) = delete;
+		BlendedAnimatable& operator = (const BlendedAnimatable&) = delete;
+
+		// Crossfades from the running layers to the new animation over `blendDurationInSeconds`.
+		// Additive layers keep running. When every slot is taken, the lightest blended layer makes room.
+		template <typename TAnimation>
+		LayerHandle WithAnimation(AnimationBuilder<TAnimation> builder, const T& targetValue, float blendDurationInSeconds = 0.0f)
+		{
+			bool blend = blendDurationInSeconds > 0.0f;
+			Layer* free = nullptr;
+			Layer* lightest = nullptr;
+
+			for (Layer& layer : m_Layers)
+			{
+				if (layer.Animation and not layer.Additive and not blend)
+				{
+					Release(layer);
+				}
+
+				if (not layer.Animation)
+				{
+					free = free != nullptr ? free : &layer;
+					continue;
+				}
+
+				if (layer.Additive)
+				{
+					continue;
+				}
+
+				layer.TargetWeight = 0.0f;
+				layer.WeightPerSecond = layer.Weight / blendDurationInSeconds;
+
+				if (lightest == nullptr or layer.Weight < lightest->Weight)
+				{
+					lightest = &layer;
+				}
+			}
+
+			if (free == nullptr)
+			{
+				Release(*lightest);
+				free = lightest;
+			}
+
+			return Acquire(*free, builder.GetAnimation(), targetValue, false, blend ? 0.0f : 1.0f, 1.0f, blend ? 1.0f / blendDurationInSeconds : 0.0f);
+		}
+
+		// Runs the animation alongside the existing layers with a constant weight.
+		// Returns an empty handle when every slot is taken.
+		template <typename TAnimation>
+		LayerHandle AddAnimation(AnimationBuilder<TAnimation> builder, const T& targetValue, float weight = 1.0f)
+		{
+			return Add(std::move(builder), targetValue, false, weight);
+		}
+
+		// Adds an offset that animates from T{} towards `offset` on top of the blended value,
+		// e.g. a shake or pulse. The layer is dropped once its animation is done, so effects
+		// should end at zero; remove repeating ones through the handle. Returns an empty handle
+		// when no slot is free or the only free slot is kept for blended layers.
+		template <typename TAnimation>
+		LayerHandle AddAdditiveAnimation(AnimationBuilder<TAnimation> builder, const T& offset, float weight = 1.0f)
+		{
+			return Add(std::move(builder), offset, true, weight);
+		}
+
+		// Drops the layer, or fades its weight to zero over `fadeOutDurationInSeconds` first.
+		// Returns false when the layer is already gone.
+		bool RemoveAnimation(LayerHandle handle, float fadeOutDurationInSeconds = 0.0f)
+		{
+			Layer* layer = Find(handle);
+			if (layer == nullptr)
+			{
+				return false;
+			}
+
+			if (fadeOutDurationInSeconds > 0.0f)
+			{
+				layer->TargetWeight = 0.0f;
+				layer->WeightPerSecond = layer->Weight / fadeOutDurationInSeconds;
+				return true;
+			}
+
+			Release(*layer);
+
+			if (m_LayerCount == 0)
+			{
+				m_CurrentValue = m_BaseValue;
+			}
+
+			return true;
+		}
+
+		bool HasAnimation(LayerHandle handle) const
+		{
+			return handle.Index < TCapacity and m_Layers[handle.Index].Animation and m_Layers[handle.Index].Generation == handle.Generation;
+		}
+
+		void WithoutAnimation(const T& targetValue)
+		{
+			for (Layer& layer : m_Layers)
+			{
+				Release(layer);
+			}
+
+			m_TargetValue = targetValue;
+			m_BaseValue = targetValue;
+			m_CurrentValue = targetValue;
+		}
+
+		// Updates every layer, blends their values and sums the additive offsets in the same pass.
+		void Update(float deltaTime)
+		{
+			if (m_LayerCount == 0)
+			{
+				return;
+			}
+
+			bool settled = true;
+			float totalWeight = 0.0f;
+			const Layer* single = nullptr;
+			std::optional<T> sum;
+			std::optional<T> offset;
+
+			for (Layer& layer : m_Layers)
+			{
+				if (not layer.Animation)
+				{
+					continue;
+				}
+
+				if (layer.Running)
+				{
+					layer.Animation->Update(layer.InitialValue, layer.TargetValue, layer.Value, deltaTime);
+					layer.Value = layer.Animation->GetValue(layer.InitialValue, layer.TargetValue, layer.Value);
+
+					if (layer.Animation->IsDone())
+					{
+						layer.Animation->OnDone();
+						layer.Running = not layer.Animation->IsDone();
+					}
+				}
+
+				if (layer.Weight < layer.TargetWeight)
+				{
+					layer.Weight = std::min(layer.Weight + layer.WeightPerSecond * deltaTime, layer.TargetWeight);
+				}
+				else
+				{
+					layer.Weight = std::max(layer.Weight - layer.WeightPerSecond * deltaTime, layer.TargetWeight);
+				}
+
+				if ((not (layer.Weight > 0.0f) and not (layer.TargetWeight > 0.0f)) or (layer.Additive and not layer.Running))
+				{
+					Release(layer);
+					continue;
+				}
+
+				if (layer.Additive)
+				{
+					settled = false;
+					offset = offset.has_value() ? *offset + layer.Value * layer.Weight : layer.Value * layer.Weight;
+					continue;
+				}
+
+				settled = settled and not layer.Running and layer.Weight == layer.TargetWeight;
+				single = totalWeight == 0.0f ? &layer : nullptr;
+				totalWeight += layer.Weight;
+				sum = sum.has_value() ? *sum + layer.Value * layer.Weight : layer.Value * layer.Weight;
+			}
+
+			if (single != nullptr)
+			{
+				m_BaseValue = single->Value;
+			}
+			else if (totalWeight > 0.0f)
+			{
+				m_BaseValue = *sum * (1.0f / totalWeight);
+			}
+
+			m_CurrentValue = offset.has_value() ? m_BaseValue + *offset : m_BaseValue;
+
+			if (settled)
+			{
+				for (Layer& layer : m_Layers)
+				{
+					Release(layer);
+				}
+			}
+		}
+
+		operator const T& () const { return m_CurrentValue; }
+		const T* operator -> () const { return &m_CurrentValue; }
+
+		const T& GetTargetValue() const { return m_TargetValue; }
+		const T& GetBaseValue() const { return m_BaseValue; }
+		const T& GetCurrentValue() const { return m_CurrentValue; }
+		const T& Get() const { return m_CurrentValue; }
+
+		std::size_t GetLayerCount() const { return m_LayerCount; }
+		bool IsAnimating() const { return m_LayerCount != 0; }
+
+	private:
+
+		template <typename TAnimation>
+		LayerHandle Add(AnimationBuilder<TAnimation> builder, const T& targetValue, bool additive, float weight)
+		{
+			Layer* free = nullptr;
+			std::size_t additiveCount = 0;
+
+			for (Layer& layer : m_Layers)
+			{
+				if (not layer.Animation)
+				{
+					free = free != nullptr ? free : &layer;
+				}
+				else if (layer.Additive)
+				{
+					++additiveCount;
+				}
+			}
+
+			if (free == nullptr or (additive and additiveCount + 1 >= TCapacity))
+			{
+				return {};
+			}
+
+			weight = std::max(weight, 0.0f);
+			return Acquire(*free, builder.GetAnimation(), targetValue, additive, weight, weight, 0.0f);
+		}
+
+		template <typename TAnimation>
+		LayerHandle Acquire(Layer& layer, TAnimation animation, const T& targetValue, bool additive, float weight, float targetWeight, float weightPerSecond)
+		{
+			layer.Animation.template Emplace<AnimationWrapperImpl<T, TAnimation>>(std::move(animation));
+			layer.Generation = layer.Generation + 1 != 0 ? layer.Generation + 1 : 1;
+			layer.Running = true;
+			layer.Additive = additive;
+			layer.InitialValue = additive ? T{} : m_BaseValue;
+			layer.TargetValue = targetValue;
+			layer.Value = layer.InitialValue;
+			layer.Weight = weight;
+			layer.TargetWeight = targetWeight;
+			layer.WeightPerSecond = weightPerSecond;
+
+			if (not additive)
+			{
+				m_TargetValue = targetValue;
+			}
+
+			++m_LayerCount;
+			return { static_cast<std::uint32_t>(&layer - m_Layers.data()), layer.Generation };
+		}
+
+		void Release(Layer& layer)
+		{
+			if (not layer.Animation)
+			{
+				return;
+			}
+
+			layer.Animation.Reset();
+			--m_LayerCount;
+		}
+
+		Layer* Find(LayerHandle handle)
+		{
+			return HasAnimation(handle) ? &m_Layers[handle.Index] : nullptr;
+		}
+
+		T m_TargetValue;
+		T m_BaseValue;
+		T m_CurrentValue;
+
+		std::array<Layer, TCapacity> m_Layers;
+		std::size_t m_LayerCount = 0;
+
+	};
+
+	template <typename T>
+	class AnimatableBuffer
+	{
+	public:
+
+		static_assert(std::is_trivially_copyable_v<T>, "snapshots are copied while other threads read them");
+
+		explicit AnimatableBuffer(std::size_t count, const T& initialValue = T{}):
+			m_Snapshots{
+				std::make_unique<std::atomic<std::uint32_t>[]>(count * WordsPerValue),
+				std::make_unique<std::atomic<std::uint32_t>[]>(count * WordsPerValue)
+			}
+		{
+			m_Values.reserve(count);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				m_Values.emplace_back(initialValue);
+				Store(0, i, initialValue);
+				Store(1, i, initialValue);
+			}
+		}
+
+		Animatable<T>& operator [] (std::size_t index) { return m_Values[index]; }
+		const Animatable<T>& operator [] (std::size_t index) const { return m_Values[index]; }
+
+		std::size_t GetSize() const
+		{
+			return m_Values.size();
+		}
+
+		void Update(float deltaTime)
+		{
+			for (Animatable<T>& value : m_Values)
+			{
+				value.Update(deltaTime);
+			}
+
+			Publish();
+		}
+
+		void Publish()
+		{
+			std::uint32_t back = 1 - m_Front.load(std::memory_order_relaxed);
+
+			m_Sequences[back].fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			for (std::size_t i = 0; i < m_Values.size(); ++i)
+			{
+				Store(back, i, m_Values[i].Get());
+			}
+
+			m_Sequences[back].fetch_add(1, std::memory_order_release);
+			m_Front.store(back, std::memory_order_release);
+		}
+
+		T Read(std::size_t index) const
+		{
+			T value;
+			ReadSnapshot([&](std::uint32_t buffer) { value = Load(buffer, index); });
+			return value;
+		}
+
+		void Read(std::span<T> destination) const
+		{
+			ReadSnapshot([&](std::uint32_t buffer)
+			{
+				std::size_t count = std::min(destination.size(), m_Values.size());
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					destination[i] = Load(buffer, i);
+				}
+			});
+		}
+
+	private:
+
+		inline static constexpr std::size_t WordsPerValue = (sizeof(T) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+
+		void Store(std::uint32_t buffer, std::size_t index, const T& value)
+		{
+			std::array<std::uint32_t, WordsPerValue> words{};
+			std::memcpy(words.data(), &value, sizeof(T));
+
+			std::atomic<std::uint32_t>* destination = &m_Snapshots[buffer][index * WordsPerValue];
+			for (std::size_t i = 0; i < WordsPerValue; ++i)
+			{
+				destination[i].store(words[i], std::memory_order_relaxed);
+			}
+		}
+
+		T Load(std::uint32_t buffer, std::size_t index) const
+		{
+			std::array<std::uint32_t, WordsPerValue> words;
+
+			const std::atomic<std::uint32_t>* source = &m_Snapshots[buffer][index * WordsPerValue];
+			for (std::size_t i = 0; i < WordsPerValue; ++i)
+			{
+				words[i] = source[i].load(std::memory_order_relaxed);
+			}
+
+			T value;
+			std::memcpy(&value, words.data(), sizeof(T));
+			return value;
+		}
+
+		template <typename TCopy>
+		void ReadSnapshot(TCopy&& copy) const
+		{
+			for (;;)
+			{
+				std::uint32_t front = m_Front.load(std::memory_order_acquire);
+				std::uint32_t sequence = m_Sequences[front].load(std::memory_order_acquire);
+				if (sequence % 2 == 1)
+				{
+					continue;
+				}
+
+				copy(front);
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (m_Sequences[front].load(std::memory_order_relaxed) == sequence)
+				{
+					return;
+				}
+			}
+		}
+
+		std::vector<Animatable<T>> m_Values;
+		std::array<std::unique_ptr<std::atomic<std::uint32_t>[]>, 2> m_Snapshots;
+		std::array<std::atomic<std::uint32_t>, 2> m_Sequences{};
+		std::atomic<std::uint32_t> m_Front = 0;
+
+	};
+
+	template <std::size_t TSlotSize = 128>
+	class AnimationCommandQueue
 	{
+	public:
+
+		explicit AnimationCommandQueue(std::size_t capacity = 1024):
+			m_Capacity(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+			m_Slots(new Slot[m_Capacity])
+		{
+			for (std::size_t i = 0; i < m_Capacity; ++i)
+			{
+				m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		AnimationCommandQueue(const AnimationCommandQueue&) = delete;
+		AnimationCommandQueue& operator = (const AnimationCommandQueue&) = delete;
+
+		~AnimationCommandQueue()
+		{
+			Consume(false);
+		}
+
+		template <typename T, typename TAnimation>
+		bool WithAnimation(Animatable<T>& animatable, AnimationBuilder<TAnimation> builder, const T& targetValue)
+		{
+			return Push([&animatable, builder = std::move(builder), targetValue]() mutable
+			{
+				animatable.WithAnimation(std::move(builder), targetValue);
+			});
+		}
+
+		template <typename T>
+		bool WithoutAnimation(Animatable<T>& animatable, const T& targetValue)
+		{
+			return Push([&animatable, targetValue]
+			{
+				animatable.WithoutAnimation(targetValue);
+			});
+		}
+
+		std::size_t Apply()
+		{
+			return Consume(true);
+		}
+
 	private:
 
-		class IAnimationWrapper
+		class ICommand
 		{
 		public:
 
-			virtual ~IAnimationWrapper() = default;
+			virtual ~ICommand() = default;
 
-			virtual bool IsDone() const = 0;
-			virtual void OnDone() = 0;
-			virtual void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime) = 0;
-			virtual T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const = 0;
+			virtual void Execute() = 0;
 
 		};
 
-		template <typename TAnimation>
-		class AnimationWrapperImpl : public IAnimationWrapper
+		template <typename TCommand>
+		class CommandImpl : public ICommand
 		{
 		public:
 
-			explicit AnimationWrapperImpl(TAnimation animation):
-				m_Animation(std::move(animation))
+			explicit CommandImpl(TCommand command):
+				m_Command(std::move(command))
+			{
+			}
+
+			virtual void Execute() override
+			{
+				m_Command();
+			}
+
+		private:
+
+			TCommand m_Command;
+
+		};
+
+		struct Slot
+		{
+			std::atomic<std::size_t> Sequence;
+			InlineObject<ICommand, TSlotSize> Command;
+		};
+
+		template <typename TCommand>
+		bool Push(TCommand command)
+		{
+			std::size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			Slot* slot = nullptr;
+
+			for (;;)
 			{
+				slot = &m_Slots[position & (m_Capacity - 1)];
+				std::size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+				if (difference == 0)
+				{
+					if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				}
 			}
 
-			virtual bool IsDone() const override
+			slot->Command.template Emplace<CommandImpl<TCommand>>(std::move(command));
+			slot->Sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		std::size_t Consume(bool execute)
+		{
+			std::size_t count = 0;
+
+			for (;; ++count, ++m_DequeuePosition)
 			{
-				return m_Animation.IsDone();
+				Slot& slot = m_Slots[m_DequeuePosition & (m_Capacity - 1)];
+				if (slot.Sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1)
+				{
+					return count;
+				}
+
+				if (execute)
+				{
+					slot.Command->Execute();
+				}
+
+				slot.Command.Reset();
+				slot.Sequence.store(m_DequeuePosition + m_Capacity, std::memory_order_release);
 			}
+		}
+
+		std::size_t m_Capacity;
+		std::unique_ptr<Slot[]> m_Slots;
+
+		alignas(64) std::atomic<std::size_t> m_EnqueuePosition = 0;
+		alignas(64) std::size_t m_DequeuePosition = 0;
 
-			virtual void OnDone() override
+	};
+
+	class ScriptFramePool
+	{
+	public:
+
+		inline static constexpr std::size_t Granularity = 64;
+		inline static constexpr std::size_t ClassCount = 32;
+
+		static void* Allocate(std::size_t size)
+		{
+			std::size_t index = (size + Granularity - 1) / Granularity;
+			if (index >= ClassCount)
 			{
-				m_Animation.OnDone();
+				return ::operator new(size);
 			}
 
-			virtual void Update(const T& initialValue, const T& targetValue, const T& currentValue, float deltaTime) override
+			FreeLists* freeLists = GetFreeLists();
+			if (freeLists == nullptr or freeLists->Heads[index] == nullptr)
 			{
-				m_Animation.Update(initialValue, targetValue, currentValue, deltaTime);
+				return ::operator new(index * Granularity);
 			}
 
-			virtual T GetValue(const T& initialValue, const T& targetValue, const T& currentValue) const override
+			Node*& head = freeLists->Heads[index];
+			Node* node = head;
+			head = node->Next;
+			return node;
+		}
+
+		static void Free(void* memory, std::size_t size)
+		{
+			std::size_t index = (size + Granularity - 1) / Granularity;
+			FreeLists* freeLists = GetFreeLists();
+			if (index >= ClassCount or freeLists == nullptr)
 			{
-				return m_Animation.GetValue(initialValue, targetValue, currentValue);
+				::operator delete(memory);
+				return;
 			}
-			
-		private:
 
-			TAnimation m_Animation;
+			Node*& head = freeLists->Heads[index];
+			head = new (memory) Node{ head };
+		}
+
+	private:
+
+		struct Node
+		{
+			Node* Next;
+		};
+
+		struct FreeLists
+		{
+			std::array<Node*, ClassCount> Heads;
+			bool& Destroyed;
+
+			~FreeLists()
+			{
+				Destroyed = true;
 
+				for (Node* head : Heads)
+				{
+					while (head != nullptr)
+					{
+						Node* next = head->Next;
+						::operator delete(head);
+						head = next;
+					}
+				}
+			}
 		};
 
+		// Returns null once this thread's lists have been destroyed, so frames released later during
+		// thread or program exit go straight back to the heap. The flag is trivially destructible
+		// and therefore still readable at that point.
+		static FreeLists* GetFreeLists()
+		{
+			thread_local bool destroyed = false;
+			thread_local FreeLists freeLists{ {}, destroyed };
+			return destroyed ? nullptr : &freeLists;
+		}
+
+	};
+
+	class AnimationScript
+	{
 	public:
 
-		constexpr Animatable(const T& initialValue = T{}):
-			m_InitialValue(initialValue),
-			m_TargetValue(initialValue),
-			m_CurrentValue(initialValue),
-			m_Animation(nullptr)
+		class promise_type
+		{
+		public:
+
+			AnimationScript get_return_object()
+			{
+				return AnimationScript(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+
+			static void* operator new(std::size_t size)
+			{
+				return ScriptFramePool::Allocate(size);
+			}
+
+			static void operator delete(void* memory, std::size_t size)
+			{
+				ScriptFramePool::Free(memory, size);
+			}
+
+			bool IsWaiting() const
+			{
+				return m_RemainingTimeInSeconds > 0.0f or (m_IsAnimating != nullptr and m_IsAnimating(m_Animatable));
+			}
+
+			void Advance(float deltaTime)
+			{
+				if (m_RemainingTimeInSeconds > 0.0f)
+				{
+					m_RemainingTimeInSeconds -= deltaTime;
+				}
+			}
+
+			bool WaitFor(float durationInSeconds)
+			{
+				m_RemainingTimeInSeconds = std::min(m_RemainingTimeInSeconds, 0.0f) + durationInSeconds;
+				m_IsAnimating = nullptr;
+				return m_RemainingTimeInSeconds > 0.0f;
+			}
+
+			void WaitFor(const void* animatable, bool(*isAnimating)(const void*))
+			{
+				m_RemainingTimeInSeconds = 0.0f;
+				m_Animatable = animatable;
+				m_IsAnimating = isAnimating;
+			}
+
+		private:
+
+			float m_RemainingTimeInSeconds = 0.0f;
+			const void* m_Animatable = nullptr;
+			bool(*m_IsAnimating)(const void*) = nullptr;
+
+		};
+
+		AnimationScript(AnimationScript&& other) noexcept:
+			m_Handle(std::exchange(other.m_Handle, nullptr))
 		{
 		}
 
-		template <typename TAnimation>
-		void WithAnimation(AnimationBuilder<TAnimation> builder, const T& targetValue)
+		AnimationScript& operator = (AnimationScript&& other) noexcept
 		{
-			m_InitialValue = m_CurrentValue;
-			m_TargetValue = targetValue;
+			std::swap(m_Handle, other.m_Handle);
+			return *this;
+		}
 
-			m_Animation.reset(new AnimationWrapperImpl<TAnimation>(builder.GetAnimation()));
+		~AnimationScript()
+		{
+			if (m_Handle)
+			{
+				m_Handle.destroy();
+			}
 		}
 
-		void WithoutAnimation(const T& targetValue)
+		std::coroutine_handle<promise_type> Release()
 		{
-			m_InitialValue = targetValue;
-			m_TargetValue = targetValue;
-			m_CurrentValue = targetValue;
-			m_Animation.reset();
+			return std::exchange(m_Handle, nullptr);
 		}
 
-		void Update(float deltaTime)
+	private:
+
+		explicit AnimationScript(std::coroutine_handle<promise_type> handle):
+			m_Handle(handle)
 		{
-			if (m_Animation == nullptr)
+		}
+
+		std::coroutine_handle<promise_type> m_Handle;
+
+	};
+
+	class AnimationScheduler
+	{
+	public:
+
+		AnimationScheduler() = default;
+		AnimationScheduler(const AnimationScheduler&) = delete;
+		AnimationScheduler& operator = (const AnimationScheduler&) = delete;
+
+		~AnimationScheduler()
+		{
+			for (std::coroutine_handle<AnimationScript::promise_type> script : m_Scripts)
+			{
+				script.destroy();
+			}
+		}
+
+		void Run(AnimationScript script)
+		{
+			std::coroutine_handle<AnimationScript::promise_type> handle = script.Release();
+			handle.resume();
+
+			if (handle.done())
 			{
+				handle.destroy();
 				return;
 			}
 
-			m_Animation->Update(m_InitialValue, m_TargetValue, m_CurrentValue, deltaTime);
-			m_CurrentValue = m_Animation->GetValue(m_InitialValue, m_TargetValue, m_CurrentValue);
-			
-			if (m_Animation->IsDone())
+			m_Scripts.push_back(handle);
+		}
+
+		void Update(float deltaTime)
+		{
+			for (std::size_t i = 0; i < m_Scripts.size();)
 			{
-				m_Animation->OnDone();
+				std::coroutine_handle<AnimationScript::promise_type> script = m_Scripts[i];
+				AnimationScript::promise_type& promise = script.promise();
+
+				promise.Advance(deltaTime);
+				if (promise.IsWaiting())
+				{
+					++i;
+					continue;
+				}
 
-				if (m_Animation->IsDone())
+				script.resume();
+
+				if (script.done())
 				{
-					m_Animation.reset();
+					script.destroy();
+					m_Scripts[i] = m_Scripts.back();
+					m_Scripts.pop_back();
+					continue;
 				}
+
+				++i;
 			}
 		}
 
-		operator const T& () const { return m_CurrentValue; }
-		const T* operator -> () const { return &m_CurrentValue; }
+		std::size_t GetScriptCount() const
+		{
+			return m_Scripts.size();
+		}
 
-		const T& GetInitialValue() const { return m_InitialValue; }
-		const T& GetTargetValue() const { return m_TargetValue; }
-		const T& GetCurrentValue() const { return m_CurrentValue; }
-		const T& Get() const { return m_CurrentValue; }
+	private:
 
-		bool IsAnimating() const { return m_Animation != nullptr; }
+		std::vector<std::coroutine_handle<AnimationScript::promise_type>> m_Scripts;
+
+	};
+
+	class WaitAwaiter
+	{
+	public:
+
+		explicit WaitAwaiter(float durationInSeconds):
+			m_DurationInSeconds(durationInSeconds)
+		{
+		}
+
+		bool await_ready() const { return false; }
+		void await_resume() const {}
+
+		bool await_suspend(std::coroutine_handle<AnimationScript::promise_type> handle) const
+		{
+			return handle.promise().WaitFor(m_DurationInSeconds);
+		}
 
 	private:
 
-		T m_InitialValue;
-		T m_TargetValue;
-		T m_CurrentValue;
+		float m_DurationInSeconds;
+
+	};
+
+	template <typename T>
+	class AnimateAwaiter
+	{
+	public:
+
+		explicit AnimateAwaiter(const Animatable<T>& animatable):
+			m_Animatable(animatable)
+		{
+		}
+
+		bool await_ready() const { return not m_Animatable.IsAnimating(); }
+		void await_resume() const {}
 
-		std::unique_ptr<IAnimationWrapper> m_Animation;
+		void await_suspend(std::coroutine_handle<AnimationScript::promise_type> handle) const
+		{
+			handle.promise().WaitFor(&m_Animatable, [](const void* animatable)
+			{
+				return static_cast<const Animatable<T>*>(animatable)->IsAnimating();
+			});
+		}
+
+	private:
+
+		const Animatable<T>& m_Animatable;
 
 	};
 
+	inline WaitAwaiter Wait(float durationInSeconds)
+	{
+		return WaitAwaiter(durationInSeconds);
+	}
+
+	template <typename T>
+	AnimateAwaiter<T> Animate(const Animatable<T>& animatable)
+	{
+		return AnimateAwaiter<T>(animatable);
+	}
+
+	template <typename T, typename TAnimation>
+	AnimateAwaiter<T> Animate(Animatable<T>& animatable, AnimationBuilder<TAnimation> builder, const T& targetValue)
+	{
+		animatable.WithAnimation(std::move(builder), targetValue);
+		return AnimateAwaiter<T>(animatable);
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "../../UIAnimation.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+static constexpr std::size_t Count = 10000;
+static constexpr std::size_t Frames = 600;
+static constexpr float DeltaTime = 1.0f / 60.0f;
+
+template <typename TAnimation>
+double Measure(const ui::AnimationBuilder<TAnimation>& builder)
+{
+	std::vector<ui::Animatable<float>> values(Count);
+	for (ui::Animatable<float>& value : values)
+	{
+		value.WithAnimation(builder, 1.0f);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	float sum = 0.0f;
+	for (std::size_t frame = 0; frame < Frames; ++frame)
+	{
+		for (ui::Animatable<float>& value : values)
+		{
+			value.Update(DeltaTime);
+			sum += value;
+		}
+	}
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	std::printf("(checksum %f) ", sum);
+	return elapsed.count() / static_cast<double>(Count * Frames);
+}
+
+int main()
+{
+	ui::AnimationLibrary library;
+	bool loaded = library.Load(
+		"pulse = EaseInOutSine(0.5).Delay(0.25).Speed(2).ReverseFor(40)\n"
+		"curve = TimingCurve(3, [0, 0.25, 0.5, 1], [InOutBounce, InOutBack, Linear]).Delay(0.5).Repeat()\n"
+	);
+
+	if (not loaded)
+	{
+		std::printf("%s\n", library.GetError().c_str());
+		return 1;
+	}
+
+	auto pulse = ui::EaseInOutSine(0.5f).Delay(0.25f).Speed(2.0f).ReverseFor(40);
+	auto curve = ui::TimingCurve(
+		3.0f,
+		std::vector{ 0.0f, 0.25f, 0.5f, 1.0f },
+		std::vector{ &ui::ease::InOutBounce, &ui::ease::InOutBack, &ui::ease::Linear }
+	).Delay(0.5f).Repeat();
+
+	std::printf("pulse template: %.2f ns/update\n", Measure(pulse));
+	std::printf("pulse compiled: %.2f ns/update\n", Measure(ui::Compile(pulse)));
+	std::printf("pulse bytecode: %.2f ns/update\n", Measure(*library.Find("pulse")));
+	std::printf("pulse baked:    %.2f ns/update\n", Measure(ui::Bake(pulse)));
+
+	std::printf("curve template: %.2f ns/update\n", Measure(curve));
+	std::printf("curve compiled: %.2f ns/update\n", Measure(ui::Compile(curve)));
+	std::printf("curve bytecode: %.2f ns/update\n", Measure(*library.Find("curve")));
+	std::printf("curve baked:    %.2f ns/update\n", Measure(ui::Bake(curve)));
+
+	return 0;
+}
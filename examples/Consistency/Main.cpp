@@ -0,0 +1,314 @@
+#include "../../UIAnimation.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <random>
+
+static int Failures = 0;
+
+static void Check(bool passed, const char* name, double error)
+{
+	std::printf("%s %s (max error %g)\n", passed ? "pass" : "FAIL", name, error);
+	Failures += passed ? 0 : 1;
+}
+
+// Steps the template, compiled and bytecode forms of one chain with the same random frame
+// times, including the occasional stall, and compares their values after every frame.
+// Chains the text format cannot express are not in the library and skip the bytecode path.
+template <typename TAnimation>
+static void CheckPaths(const char* name, const ui::AnimationBuilder<TAnimation>& builder, const ui::AnimationLibrary& library)
+{
+	ui::Animatable<float> reference(0.0f);
+	ui::Animatable<float> compiled(0.0f);
+	ui::Animatable<float> bytecode(0.0f);
+
+	reference.WithAnimation(builder, 1.0f);
+	compiled.WithAnimation(ui::Compile(builder), 1.0f);
+
+	auto loaded = library.Find(name);
+	if (loaded.has_value())
+	{
+		bytecode.WithAnimation(*loaded, 1.0f);
+	}
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> frame(0.0f, 1.0f / 30.0f);
+	std::uniform_real_distribution<float> stall(0.1f, 2.0f);
+
+	double error = 0.0;
+	for (int i = 0; i < 2000; ++i)
+	{
+		float deltaTime = i % 97 == 0 ? stall(random) : frame(random);
+
+		reference.Update(deltaTime);
+		compiled.Update(deltaTime);
+		bytecode.Update(deltaTime);
+
+		error = std::max<double>(error, std::abs(compiled.Get() - reference.Get()));
+		error = loaded.has_value() ? std::max<double>(error, std::abs(bytecode.Get() - reference.Get())) : error;
+	}
+
+	Check(error < 1e-3, name, error);
+}
+
+// One large step must land on the same cycle and phase as the closed-form answer.
+template <typename TAnimation, typename TExpected>
+static void CheckCatchUp(const char* name, const ui::AnimationBuilder<TAnimation>& builder, TExpected expected)
+{
+	double error = 0.0;
+	for (float stepInSeconds : { 0.05f, 0.37f, 2.0f, 7.93f, 31.4f })
+	{
+		ui::Animatable<float> value(0.0f);
+		value.WithAnimation(builder, 1.0f);
+		value.Update(0.01f);
+		value.Update(stepInSeconds);
+
+		error = std::max<double>(error, std::abs(value.Get() - expected(0.01 + stepInSeconds)));
+	}
+
+	Check(error < 1e-3, name, error);
+}
+
+// A chain must end at the same time, give or take one frame, whatever the frame step.
+template <typename TAnimation>
+static void CheckEndTime(const char* name, const ui::AnimationBuilder<TAnimation>& builder, double expectedInSeconds)
+{
+	double error = 0.0;
+	for (float deltaTime : { 0.25f, 0.3f, 0.01f, 1.0f / 60.0f, 0.5f, 0.7f })
+	{
+		ui::Animatable<float> value(0.0f);
+		value.WithAnimation(builder, 1.0f);
+
+		double time = 0.0;
+		while (value.IsAnimating() and time < expectedInSeconds * 2.0)
+		{
+			value.Update(deltaTime);
+			time += deltaTime;
+		}
+
+		// The last frame may overshoot the end by up to one step.
+		error = std::max(error, time < expectedInSeconds - 1e-4 ? expectedInSeconds - time : std::max(time - expectedInSeconds - deltaTime, 0.0));
+	}
+
+	Check(error < 1e-4, name, error);
+}
+
+// Played back at its own sample spacing, a baked clip may only differ by its 16-bit quantization
+// and float rounding.
+template <typename TAnimation>
+static void CheckBake(const char* name, const ui::AnimationBuilder<TAnimation>& builder)
+{
+	auto baked = ui::Bake(builder);
+	const ui::AnimationClip& clip = *baked.GetAnimation().GetClip();
+
+	// Chains that never finish are cut off when baked, so only compare the clip's length.
+	std::size_t frames = clip.GetSamples().size() - 1;
+	float deltaTime = clip.GetDurationInSeconds() / static_cast<float>(frames);
+
+	ui::Animatable<float> reference(0.0f);
+	ui::Animatable<float> playback(0.0f);
+	reference.WithAnimation(builder, 1.0f);
+	playback.WithAnimation(baked, 1.0f);
+
+	double error = 0.0;
+	for (std::size_t i = 0; i < frames; ++i)
+	{
+		reference.Update(deltaTime);
+		playback.Update(deltaTime);
+		error = std::max<double>(error, std::abs(playback.Get() - reference.Get()));
+	}
+
+	Check(error <= clip.GetScale() + 1e-5, name, error);
+}
+
+// Every input key must be reproduced within the tolerance the curve was compressed to.
+static void CheckCompression(float tolerance)
+{
+	constexpr std::size_t Count = 3000;
+	constexpr float DurationInSeconds = 50.0f;
+
+	std::vector<float> keys(Count);
+	for (std::size_t i = 0; i < Count; ++i)
+	{
+		float t = static_cast<float>(i) / static_cast<float>(Count - 1);
+		keys[i] = t < 0.3f ? ui::ease::OutBack(t / 0.3f) * 0.5f : 0.5f + ui::ease::InOutSine((t - 0.3f) / 0.7f) * 0.5f;
+	}
+
+	ui::Animatable<float> value(0.0f);
+	value.WithAnimation(ui::CompressCurve(keys, DurationInSeconds, tolerance), 1.0f);
+
+	double error = 0.0;
+	for (std::size_t i = 1; i < Count; ++i)
+	{
+		value.Update(DurationInSeconds / static_cast<float>(Count - 1));
+		error = std::max<double>(error, std::abs(value.Get() - keys[i]));
+	}
+
+	char name[64];
+	std::snprintf(name, sizeof(name), "compression within %g", tolerance);
+	Check(error <= tolerance * 1.01 + 1e-6, name, error);
+}
+
+// A written library maps and plays back its curve unchanged; damaged images are rejected.
+static void CheckMappedLibrary()
+{
+	using Library = ui::MappedAnimationLibrary;
+
+	struct alignas(Library::Alignment) Block
+	{
+		std::byte Bytes[Library::Alignment];
+	};
+
+	std::vector<float> values = { 0.0f, 0.25f, 0.5f, 1.0f };
+	std::vector<ui::EaseFunction> functions = { &ui::ease::InOutBounce, &ui::ease::InOutBack, &ui::ease::Linear };
+
+	Library::Writer writer;
+	writer.AddCurve("a", 3.0f, values, functions);
+	writer.AddCurve("b", 1.0f, values, functions);
+	std::vector<std::byte> image = writer.Finish();
+
+	auto map = [&](auto damage)
+	{
+		std::vector<Block> blocks((image.size() + sizeof(Block) - 1) / sizeof(Block));
+		std::memcpy(blocks.data(), image.data(), image.size());
+
+		std::span<std::byte> bytes(reinterpret_cast<std::byte*>(blocks.data()), image.size());
+		damage(bytes);
+
+		Library library;
+		bool mapped = library.Map(bytes);
+		return std::pair{ mapped, mapped ? library.FindCurve("a").has_value() : false };
+	};
+
+	auto header = [](std::span<std::byte> bytes)
+	{
+		Library::Header value;
+		std::memcpy(&value, bytes.data(), sizeof(value));
+		return value;
+	};
+
+	auto entries = [&](std::span<std::byte> bytes)
+	{
+		return reinterpret_cast<Library::Entry*>(bytes.data() + header(bytes).EntryOffset);
+	};
+
+	bool passed = map([](std::span<std::byte>) {}) == std::pair{ true, true };
+	passed = passed and not map([](std::span<std::byte> bytes) { bytes[0] = std::byte{ 'X' }; }).first;
+	passed = passed and not map([](std::span<std::byte> bytes) { bytes[4] = std::byte{ 99 }; }).first;
+	passed = passed and not map([](std::span<std::byte> bytes) { bytes[12] = std::byte{ 1 }; }).first;
+	passed = passed and not map([&](std::span<std::byte> bytes) { entries(bytes)[0].ValueOffset = 0x7FFFFFF0; }).first;
+	passed = passed and not map([&](std::span<std::byte> bytes) { bytes[entries(bytes)[0].FunctionOffset] = std::byte{ 0xFF }; }).first;
+	passed = passed and not map([&](std::span<std::byte> bytes) { std::swap(entries(bytes)[0], entries(bytes)[1]); }).first;
+
+	Library library;
+	std::vector<Block> blocks((image.size() + sizeof(Block) - 1) / sizeof(Block));
+	std::memcpy(blocks.data(), image.data(), image.size());
+	passed = passed and library.Map(std::span(reinterpret_cast<const std::byte*>(blocks.data()), image.size()));
+
+	ui::Animatable<float> reference(0.0f);
+	ui::Animatable<float> mapped(0.0f);
+	reference.WithAnimation(ui::TimingCurve(3.0f, values, functions), 1.0f);
+	mapped.WithAnimation(*library.FindCurve("a"), 1.0f);
+
+	double error = 0.0;
+	for (int i = 0; i < 200; ++i)
+	{
+		reference.Update(1.0f / 60.0f);
+		mapped.Update(1.0f / 60.0f);
+		error = std::max<double>(error, std::abs(mapped.Get() - reference.Get()));
+	}
+
+	Check(passed and error == 0.0, "mapped library", error);
+}
+
+// A reload with a syntax error reports it and keeps the animations from the last successful load.
+static void CheckFailedReload()
+{
+	ui::AnimationLibrary library;
+	bool passed = library.Load("fade = EaseLinear(1)\n");
+	std::vector<std::uint32_t> code = library.GetCode();
+
+	passed = passed and not library.Load("pulse = EaseLinear(0.5)\nbroken = EaseLinear(\n");
+	passed = passed and not library.GetError().empty();
+	passed = passed and library.Find("fade").has_value() and not library.Find("pulse").has_value();
+	passed = passed and library.GetCode() == code;
+
+	passed = passed and library.Load("pulse = EaseLinear(0.5)\n");
+	passed = passed and library.GetError().empty();
+	passed = passed and library.Find("pulse").has_value() and not library.Find("fade").has_value();
+
+	Check(passed, "failed reload", 0.0);
+}
+
+int main()
+{
+	ui::AnimationLibrary library;
+	bool loaded = library.Load(
+		"pulse = EaseInOutSine(0.5).Delay(0.25).Speed(2).ReverseFor(40)\n"
+		"curve = TimingCurve(3, [0, 0.25, 0.5, 1], [InOutBounce, InOutBack, Linear]).Delay(0.5).Repeat()\n"
+		"bounce = EaseOutBounce(0.7).Speed(0.5).RepeatFor(9)\n"
+		"offset = TimingCurve(2, [0.5, 0.8, 1], [OutCubic, Linear]).Delay(1).RepeatFor(3)\n"
+	);
+
+	if (not loaded)
+	{
+		std::printf("%s\n", library.GetError().c_str());
+		return 1;
+	}
+
+	auto pulse = ui::EaseInOutSine(0.5f).Delay(0.25f).Speed(2.0f).ReverseFor(40);
+	auto curve = ui::TimingCurve(
+		3.0f,
+		std::vector{ 0.0f, 0.25f, 0.5f, 1.0f },
+		std::vector{ &ui::ease::InOutBounce, &ui::ease::InOutBack, &ui::ease::Linear }
+	).Delay(0.5f).Repeat();
+	auto bounce = ui::EaseOutBounce(0.7f).Speed(0.5f).RepeatFor(9);
+	auto offset = ui::TimingCurve(
+		2.0f,
+		std::vector{ 0.5f, 0.8f, 1.0f },
+		std::vector{ &ui::ease::OutCubic, &ui::ease::Linear }
+	).Delay(1.0f).RepeatFor(3);
+	auto reversed = ui::Ease(ui::ease::Reverse(ui::ease::Curve<&ui::ease::OutCubic>{}), 1.0f).Delay(1.0f).RepeatFor(2);
+
+	CheckPaths("pulse", pulse, library);
+	CheckPaths("curve", curve, library);
+	CheckPaths("bounce", bounce, library);
+	CheckPaths("offset", offset, library);
+	CheckPaths("reversed", reversed, library);
+
+	CheckCatchUp("repeat catch-up", ui::EaseLinear(0.1f).Repeat(), [](double time)
+	{
+		double phase = time / 0.1;
+		return phase - std::floor(phase);
+	});
+
+	CheckCatchUp("reverse catch-up", ui::EaseLinear(0.1f).Repeat(ui::Predicate::Always, ui::Predicate::Always), [](double time)
+	{
+		double phase = time / 0.1;
+		double fraction = phase - std::floor(phase);
+		return static_cast<long long>(std::floor(phase)) % 2 == 0 ? fraction : 1.0 - fraction;
+	});
+
+	CheckCatchUp("finite repeat catch-up", ui::EaseLinear(0.1f).RepeatFor(5), [](double time)
+	{
+		double phase = time / 0.1;
+		return phase >= 5.0 ? 1.0 : phase - std::floor(phase);
+	});
+
+	CheckEndTime("nested repeat end time", ui::EaseLinear(1.0f).RepeatFor(3).RepeatFor(2), 4.0);
+	CheckEndTime("nested reverse end time", ui::EaseLinear(1.0f).ReverseFor(3, ui::Predicate::Countdown(2)).RepeatFor(2), 4.0);
+
+	CheckBake("bake ping-pong", ui::EaseInOutSine(0.5f).Delay(0.25f).Speed(2.0f).Repeat(ui::Predicate::Always, ui::Predicate::Always));
+	CheckBake("bake bounce", bounce);
+
+	CheckCompression(0.0005f);
+	CheckCompression(0.01f);
+	CheckEndTime("two-sample compression end time", ui::CompressCurve(std::vector{ 0.0f, 1.0f }, 2.0f, 0.01f), 2.0);
+
+	CheckMappedLibrary();
+	CheckFailedReload();
+
+	std::printf("%d failure(s)\n", Failures);
+	return Failures == 0 ? 0 : 1;
+}